@@ -49,29 +49,30 @@ typealias StatFS = statfs
 		let arguments = ProcessInfo.processInfo.arguments
 		let inputFileURL: URL? = (arguments.count >= 2) ? URL(fileURLWithPath: arguments[1]) : nil
 		
-		let tutorialMode: Bool
-		var commitFileURL: URL?
-		var tempDirectoryURL: URL?
-		
-		if let fileURL = inputFileURL {
+		// The launch trace starts here so it also covers checking the commit file
+		// This check runs before the launch pipeline rather than in it because it decides which file the pipeline loads
+		let launchTrace = LaunchTrace()
+		let inputCommitFileURL = launchTrace.measure("Check commit file") { () -> URL? in
+			guard let fileURL = inputFileURL else {
+				return nil
+			}
+			
 			if let reachable = try? fileURL.checkResourceIsReachable(), reachable {
-				commitFileURL = fileURL
-				tutorialMode = false
-			} else if TextProcessor.isConfigFile(fileURL) {
-				// Some configuration files may not exist yet, create the config file in this case
-				if fileManager.createFile(atPath: fileURL.path, contents: nil), let reachable = try? fileURL.checkResourceIsReachable(), reachable {
-					commitFileURL = fileURL
-					tutorialMode = false
-				} else {
-					tutorialMode = true
-				}
-			} else {
-				tutorialMode = true
+				return fileURL
 			}
-		} else {
-			tutorialMode = true
+			
+			// Some configuration files may not exist yet, create the config file in this case
+			if TextProcessor.isConfigFile(fileURL), fileManager.createFile(atPath: fileURL.path, contents: nil), let reachable = try? fileURL.checkResourceIsReachable(), reachable {
+				return fileURL
+			}
+			
+			return nil
 		}
 		
+		let tutorialMode = (inputCommitFileURL == nil)
+		var commitFileURL = inputCommitFileURL
+		var tempDirectoryURL: URL?
+		
 		if tutorialMode {
 			let executableIsOnReadOnlyMount = executableURL.withUnsafeFileSystemRepresentation { fileSystemRepresentation -> Bool in
 				var statInfo = StatFS()
@@ -212,7 +213,7 @@ typealias StatFS = statfs
 			fatalError("Failed to retrieve commit file URL to edit")
 		}
 		
-		let editorWindowController = ZGEditorWindowController(fileURL: commitFileURL, temporaryDirectoryURL: tempDirectoryURL, tutorialMode: tutorialMode)
+		let editorWindowController = ZGEditorWindowController(fileURL: commitFileURL, temporaryDirectoryURL: tempDirectoryURL, tutorialMode: tutorialMode, launchTrace: launchTrace)
 		self.editorWindowController = editorWindowController
 		editorWindowController.showWindow(nil)
 		
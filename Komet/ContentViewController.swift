@@ -8,11 +8,7 @@
 
 import Cocoa
 
-enum FileChangeType: Equatable {
-	case added
-	case deleted
-	case modified
-}
+private let COLLAPSED_SCISSORED_CONTENT_LINK = "komet-expand-scissored-content"
 
 class ContentViewController: NSViewController, NSTextStorageDelegate, NSTextContentStorageDelegate, ZGCommitViewDelegate, NSTextViewDelegate {
 	@IBOutlet private var scrollViewContainer: NSView!
@@ -20,28 +16,30 @@ class ContentViewController: NSViewController, NSTextStorageDelegate, NSTextCont
 	private var textView: ZGCommitTextView!
 	private var scrollView: NSScrollView!
 	
-	private let initialPlainText: String
-	private let commentSectionLength: Int
-	private let commentVersionControlType: VersionControlType
-	private let resumedFromSavedCommit: Bool
-	private let initialCommitTextRange: Range<String.UTF16View.Index>
-	private let isSquashMessage: Bool
+	private let launchPipeline: LaunchPipeline
 	private let versionControlledFile: Bool
 	
+	// These are known once the commit file is loaded, right before the text storage is populated
+	private var commentSectionLength: Int = 0
+	private var commentVersionControlType: VersionControlType = .git
+	// Looked up once rather than for every paragraph that is styled
+	private var commentSyntax: any CommentSyntax = GitCommentSyntax()
+	private var isSquashMessage: Bool = false
+	private var lineIndex = CommitLineIndex(versionControlType: .git, commentSectionLength: 0)
+	private var collapsedScissoredContent: CollapsedScissoredContent?
+	private var commentSectionHighlights: CommentSectionHighlights?
+	
 	private var preventAccidentalNewline: Bool = false
 	
 	var breadcrumbs: Breadcrumbs?
 	
 	var commitHandler: (() -> ())? = nil
 	var cancelHandler: (() -> ())? = nil
+	// Called if the commit file couldn't be read or parsed
+	var loadFailureHandler: ((Error) -> ())? = nil
 	
-	init(initialPlainText: String, commentSectionLength: Int, commentVersionControlType: VersionControlType, resumedFromSavedCommit: Bool, initialCommitTextRange: Range<String.UTF16View.Index>, isSquashMessage: Bool, versionControlledFile: Bool, breadcrumbs: Breadcrumbs?) {
-		self.initialPlainText = initialPlainText
-		self.commentSectionLength = commentSectionLength
-		self.commentVersionControlType = commentVersionControlType
-		self.resumedFromSavedCommit = resumedFromSavedCommit
-		self.initialCommitTextRange = initialCommitTextRange
-		self.isSquashMessage = isSquashMessage
+	init(launchPipeline: LaunchPipeline, versionControlledFile: Bool, breadcrumbs: Breadcrumbs?) {
+		self.launchPipeline = launchPipeline
 		self.versionControlledFile = versionControlledFile
 		self.breadcrumbs = breadcrumbs
 		
@@ -182,11 +180,44 @@ class ContentViewController: NSViewController, NSTextStorageDelegate, NSTextCont
 		textView.delegate = self
 		textView.zgCommitViewDelegate = self
 		
+		// The commit file has been loading in the background while the window and text view were built
+		let loadedCommit: LoadedCommit
+		do {
+			loadedCommit = try launchPipeline.wait()
+		} catch {
+			loadFailureHandler?(error)
+			return
+		}
+		
+		let initialPlainText = loadedCommit.initialPlainText
+		let initialCommitTextRange = loadedCommit.initialCommitTextRange
+		
+		commentSectionLength = loadedCommit.commentSectionLength
+		commentVersionControlType = loadedCommit.commentVersionControlType
+		commentSyntax = loadedCommit.commentVersionControlType.commentSyntax
+		isSquashMessage = loadedCommit.isSquashMessage
+		collapsedScissoredContent = loadedCommit.collapsedScissoredContent
+		
+		// The comment section was classified while loading, so the initial paragraphs can be styled from it
+		commentSectionHighlights = loadedCommit.commentSectionHighlights
+		
+		// The line index gets built when the initial text is inserted into the text storage
+		lineIndex = CommitLineIndex(versionControlType: commentVersionControlType, commentSectionLength: commentSectionLength)
+		
 		let plainAttributedString = NSMutableAttributedString(string: initialPlainText)
 		
+		// Clicking the placeholder for collapsed scissored content expands it
+		// NSTextView finds clicked links from the text storage's attributes, not from the paragraphs we display
+		if let collapsedScissoredContent {
+			let placeholderLength = collapsedScissoredContent.placeholder.utf16.count
+			plainAttributedString.addAttribute(.link, value: COLLAPSED_SCISSORED_CONTENT_LINK, range: NSMakeRange(plainAttributedString.length - placeholderLength, placeholderLength))
+		}
+		
 		// I don't think we want to invoke beginEditing/endEditing, etc, events because we are setting the textview content for the first time,
 		// and we don't want anything to register as user-editable yet or have undo activated yet
-		textView.textStorage?.replaceCharacters(in: NSMakeRange(0, 0), with: plainAttributedString)
+		launchPipeline.trace.measure("Populate text storage") {
+			textView.textStorage?.replaceCharacters(in: NSMakeRange(0, 0), with: plainAttributedString)
+		}
 		
 		updateTextViewDrawingBackground()
 		
@@ -196,7 +227,7 @@ class ContentViewController: NSViewController, NSTextStorageDelegate, NSTextCont
 		if !versionControlledFile {
 			textView.setSelectedRange(NSMakeRange(0, 0))
 		} else {
-			if resumedFromSavedCommit {
+			if loadedCommit.resumedFromSavedCommit {
 				textView.setSelectedRange(TextProcessor.convertToUTF16Range(range: initialCommitTextRange, in: initialPlainText))
 			} else {
 				textView.setSelectedRange(TextProcessor.convertToUTF16Range(range: initialCommitTextRange.upperBound ..< initialCommitTextRange.upperBound, in: initialPlainText))
@@ -216,6 +247,31 @@ class ContentViewController: NSViewController, NSTextStorageDelegate, NSTextCont
 		breadcrumbs?.spellChecking = textView.isContinuousSpellCheckingEnabled
     }
 	
+	// Re-classifies the comment section after it changes, such as when collapsed content is expanded
+	private func buildCommentSectionHighlights(plainText: String) {
+		commentSectionHighlights = nil
+		
+		let commentSectionLength = self.commentSectionLength
+		guard versionControlledFile && commentSectionLength > 0 else {
+			return
+		}
+		
+		let versionControlType = commentVersionControlType
+		DispatchQueue.global(qos: .userInitiated).async {
+			let commentSectionIndex = TextProcessor.commentSectionIndex(plainUTF16Text: plainText.utf16, commentSectionLength: commentSectionLength)
+			let highlights = CommentSectionHighlights(commentSectionText: String(plainText[commentSectionIndex...]), versionControlType: versionControlType)
+			
+			DispatchQueue.main.async { [weak self] in
+				// Make sure the comment section hasn't been expanded in the meantime
+				guard let self, self.commentSectionLength == commentSectionLength else {
+					return
+				}
+				
+				self.commentSectionHighlights = highlights
+			}
+		}
+	}
+	
 	private func updateTextViewDrawingBackground() {
 		textView.drawsBackground = false
 	}
@@ -233,6 +289,49 @@ class ContentViewController: NSViewController, NSTextStorageDelegate, NSTextCont
 		return textStorage?.string ?? ""
 	}
 	
+	// Data to write back to the commit file, including any scissored content that was never loaded
+	func commitFileData() -> Data {
+		let plainText = currentPlainText()
+		guard let collapsedScissoredContent else {
+			return Data(plainText.utf8)
+		}
+		
+		let utf16View = plainText.utf16
+		let placeholderIndex = utf16View.index(utf16View.endIndex, offsetBy: -collapsedScissoredContent.placeholder.utf16.count)
+		
+		var data = Data(plainText[..<placeholderIndex].utf8)
+		data.append(collapsedScissoredContent.data)
+		return data
+	}
+	
+	private func expandCollapsedScissoredContent() {
+		guard let collapsedScissoredContent, let textStorage = textView.textStorage else {
+			return
+		}
+		
+		// Content is only collapsed if it's valid UTF-8, but if it can't be decoded anyway the placeholder stays in place
+		// and the content is still written back unchanged
+		guard let expandedContent = String(data: collapsedScissoredContent.data, encoding: .utf8) else {
+			print("Failed to decode collapsed scissored content of \(collapsedScissoredContent.data.count) bytes")
+			return
+		}
+		
+		let placeholderLength = collapsedScissoredContent.placeholder.utf16.count
+		let placeholderRange = NSMakeRange(textStorage.length - placeholderLength, placeholderLength)
+		
+		self.collapsedScissoredContent = nil
+		commentSectionLength += expandedContent.utf16.count - placeholderLength
+		
+		// The line index will be re-built once the text storage processes this edit
+		lineIndex = CommitLineIndex(versionControlType: commentVersionControlType, commentSectionLength: commentSectionLength)
+		
+		// The comment section is not user editable so this change does not need to be undoable
+		// Replacing with an attributed string makes sure the expanded content doesn't inherit the placeholder's link
+		textStorage.replaceCharacters(in: placeholderRange, with: NSAttributedString(string: expandedContent))
+		
+		buildCommentSectionHighlights(plainText: textStorage.string)
+	}
+	
 	func commitMessageContent() -> String {
 		let plainText = currentPlainText()
 		let commitRange = TextProcessor.commitTextRange(plainText: plainText, commentLength: commentSectionLength)
@@ -266,39 +365,29 @@ class ContentViewController: NSViewController, NSTextStorageDelegate, NSTextCont
 			return
 		}
 		
-		func retrieveLineRanges(plainText: String) -> [Range<String.Index>] {
-			var lineRanges: [Range<String.Index>] = []
-			var characterIndex = plainText.startIndex
-			while characterIndex < plainText.endIndex {
-				var lineStartIndex = String.Index(utf16Offset: 0, in: plainText)
-				var lineEndIndex = String.Index(utf16Offset: 0, in: plainText)
-				var contentEndIndex = String.Index(utf16Offset: 0, in: plainText)
-				
-				plainText.getLineStart(&lineStartIndex, end: &lineEndIndex, contentsEnd: &contentEndIndex, for: characterIndex ..< characterIndex)
-				
-				let lineRange = (lineStartIndex ..< contentEndIndex)
-				lineRanges.append(lineRange)
-				
-				characterIndex = lineEndIndex
-			}
-			return lineRanges
-		}
-		
-		if let textContentStorage = textView.textContentStorage {
-			let currentText = currentPlainText()
-			let contentLineRanges = retrieveLineRanges(plainText: currentText)
-			
-			for contentLineRange in contentLineRanges {
-				let utf16Range = TextProcessor.convertToUTF16Range(range: contentLineRange, in: currentText)
+		if let textContentStorage = textView.textContentStorage, let text = textView.textStorage?.mutableString {
+			for lineNumber in 0 ..< lineIndex.lineCount {
+				let utf16Range = lineIndex.lineRange(at: lineNumber, in: text)
 				let _ = newTextParagraph(textContentStorage, range: utf16Range, updateBreadcrumbs: true)
 			}
 		}
 	}
 	
+	// MARK: Text Storage Delegates
+	
+	func textStorage(_ textStorage: NSTextStorage, didProcessEditing editedMask: NSTextStorage.EditActions, range editedRange: NSRange, changeInLength delta: Int) {
+		guard editedMask.contains(.editedCharacters) else {
+			return
+		}
+		
+		// This is invoked before the text content storage re-generates any paragraphs
+		lineIndex.textDidChange(textStorage.mutableString, editedRange: editedRange, changeInLength: delta)
+	}
+	
 	// MARK: Text View Delegates
 	
 	@objc func textView(_ textView: NSTextView, shouldChangeTextInRanges affectedRanges: [NSValue], replacementStrings: [String]?) -> Bool {
-		let commentRange = TextProcessor.commentUTF16Range(plainText: currentPlainText(), commentSectionLength: commentSectionLength)
+		let commentRange = NSMakeRange(lineIndex.commentSectionLocation, commentSectionLength)
 		
 		// Don't allow editing the comment section
 		// Make sure to also check we have a comment section, otherwise we would be
@@ -325,263 +414,115 @@ class ContentViewController: NSViewController, NSTextStorageDelegate, NSTextCont
 			return nil
 		}
 		
-		let originalTextString = originalText.string
+		let userDefaults = UserDefaults.standard
 		
-		let commentRange: NSRange
-		let plainText = currentPlainText()
-		do {
-			commentRange = TextProcessor.commentUTF16Range(plainText: plainText, commentSectionLength: commentSectionLength)
+		let subjectLengthLimit = Self.lengthLimitWarningEnabled(userDefaults: userDefaults, userDefaultKey: ZGEditorRecommendedSubjectLengthLimitEnabledKey, versionControlledFile: versionControlledFile) ? ZGReadDefaultLineLimit(userDefaults, ZGEditorRecommendedSubjectLengthLimitKey) : nil
+		let bodyLineLengthLimit = Self.lengthLimitWarningEnabled(userDefaults: userDefaults, userDefaultKey: ZGEditorRecommendedBodyLineLengthLimitEnabledKey, versionControlledFile: versionControlledFile) ? ZGReadDefaultLineLimit(userDefaults, ZGEditorRecommendedBodyLineLengthLimitKey) : nil
+		let classifierOptions = CommitLineClassifier.Options(versionControlledFile: versionControlledFile, isSquashMessage: isSquashMessage, subjectLengthLimit: subjectLengthLimit, bodyLineLengthLimit: bodyLineLengthLimit, highlightsFileChanges: userDefaults.bool(forKey: ZGHighlightFileChangesKey))
+		
+		// Lines in the comment section are classified ahead of time, but the classifier may need to classify it now if that hasn't finished yet
+		let classification = CommitLineClassifier.classify(originalText.string, location: range.location, lineIndex: lineIndex, commentSectionHighlights: commentSectionHighlights, commentSyntax: commentSyntax, options: classifierOptions)
+		
+		if updateBreadcrumbs && breadcrumbs != nil {
+			classification.record(in: &breadcrumbs!, location: range.location)
 		}
 		
-		let paragraphWithDisplayAttributes: NSTextParagraph?
-		let isCommentSection = (range.location >= commentRange.location)
-		let isCommentLine = TextProcessor.isCommentLine(originalTextString, versionControlType: commentVersionControlType)
-		let hasSingleCommentLineMarker = TextProcessor.hasSingleCommentLineMarker(versionControlType: commentVersionControlType)
-		// For svn we want to test isCommentSection
-		// For git, we want to test isCommentLine. Scissored content may be in the comment section but
-		// we don't want to format those lines as comments
-		let isCommentParagraph = isCommentLine || (hasSingleCommentLineMarker && isCommentSection)
-
-		let userDefaults = UserDefaults.standard
+		let textWithDisplayAttributes = NSMutableAttributedString(attributedString: originalText)
+		let fullTextRange = NSMakeRange(0, range.length)
 		
-		if !isCommentParagraph {
+		if !classification.kind.isComment {
 			let contentFont = ZGReadDefaultFont(userDefaults, ZGMessageFontNameKey, ZGMessageFontPointSizeKey)
 			
 			let displayAttributes: [NSAttributedString.Key: AnyObject] = [.font: contentFont, .foregroundColor: style.textColor]
-			
-			let textWithDisplayAttributes = NSMutableAttributedString(attributedString: originalText)
-			
-			let fullTextRange = NSMakeRange(0, range.length)
 			textWithDisplayAttributes.addAttributes(displayAttributes, range: fullTextRange)
 			
-			if versionControlledFile {
-				let handleScissoredLineDiffing: Bool
-				switch commentVersionControlType {
-				case .jj:
-					fallthrough
-				case .git:
-					handleScissoredLineDiffing = true
-				case .svn:
-					fallthrough
-				case .hg:
-					handleScissoredLineDiffing = false
-				}
+			let diffAttributeColor: NSColor?
+			switch classification.kind {
+			case .diffHeader:
+				diffAttributeColor = style.diffHeaderColor
+			case .diffAdd:
+				diffAttributeColor = style.diffAddColor
+			case .diffRemove:
+				diffAttributeColor = style.diffRemoveColor
+			case .content, .overflowingContent, .comment, .commentSectionComment, .commentSectionPlain, .fileModified, .fileAdded, .fileDeleted:
+				diffAttributeColor = nil
+			}
+			
+			if let diffAttributeColor {
+				let diffAttributeKey = style.diffHighlightsBackground ? NSAttributedString.Key.backgroundColor : NSAttributedString.Key.foregroundColor
+				let diffAttributes: [NSAttributedString.Key : AnyObject] = [.font: contentFont, diffAttributeKey: diffAttributeColor]
 				
-				if handleScissoredLineDiffing && isCommentSection {
-					// Handle highlighting diffs
-					
-					let diffAttributeKey = style.diffHighlightsBackground ? NSAttributedString.Key.backgroundColor : NSAttributedString.Key.foregroundColor
-					
-					let diffAttributeColor: NSColor?
-					
-					// https://git-scm.com/docs/git-diff-index documents the possible header line prefixes
-					if originalTextString.hasPrefix("@@") ||
-						originalTextString.hasPrefix("+++") ||
-						originalTextString.hasPrefix("---") ||
-						originalTextString.hasPrefix("diff ") ||
-						(originalTextString.hasPrefix("index ") && originalTextString.contains("..")) ||
-						originalTextString.hasPrefix("deleted file mode") ||
-						originalTextString.hasPrefix("new file mode") ||
-						originalTextString.hasPrefix("copy from") ||
-						originalTextString.hasPrefix("copy to") ||
-						originalTextString.hasPrefix("rename from") ||
-						originalTextString.hasPrefix("rename to") ||
-						originalTextString.hasPrefix("similarity index") ||
-						originalTextString.hasPrefix("dissimilarity index") ||
-						originalTextString.hasPrefix("old mode") ||
-						originalTextString.hasPrefix("new mode") {
-						diffAttributeColor = style.diffHeaderColor
-						
-						if updateBreadcrumbs && breadcrumbs != nil {
-							breadcrumbs!.diffHeaderLineRanges.append(fullTextRange.location ..< NSMaxRange(fullTextRange))
-						}
-					} else if originalTextString.hasPrefix("+") {
-						diffAttributeColor = style.diffAddColor
-						
-						if updateBreadcrumbs && breadcrumbs != nil {
-							breadcrumbs!.diffAddLineRanges.append(fullTextRange.location ..< NSMaxRange(fullTextRange))
-						}
-					} else if originalTextString.hasPrefix("-") {
-						diffAttributeColor = style.diffRemoveColor
-						
-						if updateBreadcrumbs && breadcrumbs != nil {
-							breadcrumbs!.diffRemoveLineRanges.append(fullTextRange.location ..< NSMaxRange(fullTextRange))
-						}
-					} else {
-						diffAttributeColor = nil
-					}
-					
-					if let diffAttributeColor {
-						let diffAttributes: [NSAttributedString.Key : AnyObject] = [.font: contentFont, diffAttributeKey: diffAttributeColor]
-						
-						textWithDisplayAttributes.addAttributes(diffAttributes, range: fullTextRange)
-					}
-				} else if !isSquashMessage {
-					// Render text overflow highlights
-					
-					if let startContentLineIndex = TextProcessor.firstContentLineIndex(plainText: plainText, versionControlType: commentVersionControlType) {
-						
-						let lengthLimit: Int?
-						let startContentLocationRange = TextProcessor.convertToUTF16Range(range: startContentLineIndex ..< startContentLineIndex, in: plainText)
-						
-						if range.location == startContentLocationRange.location {
-							lengthLimit = Self.lengthLimitWarningEnabled(userDefaults: userDefaults, userDefaultKey: ZGEditorRecommendedSubjectLengthLimitEnabledKey, versionControlledFile: versionControlledFile) ? ZGReadDefaultLineLimit(userDefaults, ZGEditorRecommendedSubjectLengthLimitKey) : nil
-						} else {
-							lengthLimit = Self.lengthLimitWarningEnabled(userDefaults: userDefaults, userDefaultKey: ZGEditorRecommendedBodyLineLengthLimitEnabledKey, versionControlledFile: versionControlledFile) ? ZGReadDefaultLineLimit(userDefaults, ZGEditorRecommendedBodyLineLengthLimitKey) : nil
-						}
-						
-						if let lengthLimit {
-							let distance = originalTextString.distance(from: originalTextString.startIndex, to: originalTextString.endIndex)
-							
-							if distance > lengthLimit {
-								let overflowRange = originalTextString.index(originalTextString.startIndex, offsetBy: lengthLimit) ..< originalTextString.endIndex
-								
-								let overflowUtf16Range = TextProcessor.convertToUTF16Range(range: overflowRange, in: originalTextString)
-								
-								let overflowAttributes: [NSAttributedString.Key: AnyObject] = [.font: contentFont, .backgroundColor: style.overflowColor]
-								
-								textWithDisplayAttributes.addAttributes(overflowAttributes, range: overflowUtf16Range)
-								
-								if updateBreadcrumbs && breadcrumbs != nil {
-									breadcrumbs!.textOverflowRanges.append(range.location + overflowUtf16Range.location ..< range.location + NSMaxRange(overflowUtf16Range))
-								}
-							}
-						}
-					}
-				}
+				textWithDisplayAttributes.addAttributes(diffAttributes, range: fullTextRange)
 			}
 			
-			paragraphWithDisplayAttributes = NSTextParagraph(attributedString: textWithDisplayAttributes)
+			if let overflowRange = classification.overflowRange {
+				let overflowAttributes: [NSAttributedString.Key: AnyObject] = [.font: contentFont, .backgroundColor: style.overflowColor]
+				
+				textWithDisplayAttributes.addAttributes(overflowAttributes, range: overflowRange)
+			}
 		} else {
 			let commentFont = ZGReadDefaultFont(userDefaults, ZGCommentsFontNameKey, ZGCommentsFontPointSizeKey)
 			
-			var commentChangeColorAndCommentPrefixLength: (FileChangeType, Int)? = nil
-			if isCommentSection && versionControlledFile && UserDefaults.standard.bool(forKey: ZGHighlightFileChangesKey) {
-				if #available(macOS 13, *) {
-					if let (label, commentPrefixLength) = TextProcessor.labelInCommentLine(originalText.string, versionControlType: commentVersionControlType) {
-						switch commentVersionControlType {
-						case .git:
-							switch label {
-							case "renamed": fallthrough
-							case "copied": fallthrough
-							case "modified":
-								commentChangeColorAndCommentPrefixLength = (.modified, commentPrefixLength)
-							case "new file":
-								commentChangeColorAndCommentPrefixLength = (.added, commentPrefixLength)
-							case "deleted":
-								commentChangeColorAndCommentPrefixLength = (.deleted, commentPrefixLength)
-							default:
-								break
-							}
-						case .jj:
-							switch label {
-							case "R": fallthrough
-							case "C": fallthrough
-							case "M":
-								commentChangeColorAndCommentPrefixLength = (.modified, commentPrefixLength)
-							case "A":
-								commentChangeColorAndCommentPrefixLength = (.added, commentPrefixLength)
-							case "D":
-								commentChangeColorAndCommentPrefixLength = (.deleted, commentPrefixLength)
-							default:
-								break
-							}
-						case .hg:
-							switch label {
-							case "changed":
-								commentChangeColorAndCommentPrefixLength = (.modified, commentPrefixLength)
-							case "added":
-								commentChangeColorAndCommentPrefixLength = (.added, commentPrefixLength)
-							case "removed":
-								commentChangeColorAndCommentPrefixLength = (.deleted, commentPrefixLength)
-							default:
-								break
-							}
-						case .svn:
-							// Not testing svn
-							break
-						}
-					}
-				}
-			}
-			
-			let textWithDisplayAttributes = NSMutableAttributedString(attributedString: originalText)
-			
-			if let (fileChangeType, commentPrefixLength) = commentChangeColorAndCommentPrefixLength {
+			if let fileChangeRange = classification.fileChangeRange {
 				do {
 					let displayAttributes: [NSAttributedString.Key: AnyObject] = [.font: commentFont, .foregroundColor: style.commentColor]
-					textWithDisplayAttributes.addAttributes(displayAttributes, range: NSMakeRange(0, commentPrefixLength))
+					textWithDisplayAttributes.addAttributes(displayAttributes, range: NSMakeRange(0, fileChangeRange.location))
 				}
 				
-				if range.length > commentPrefixLength {
-					let fileChangedTextRange = NSMakeRange(commentPrefixLength, range.length - commentPrefixLength)
-					
-					let commentChangeColor: NSColor
-					switch fileChangeType {
-					case .modified:
-						commentChangeColor = style.changeModifiedColor
-						
-						if updateBreadcrumbs && breadcrumbs != nil {
-							breadcrumbs!.fileChangeModifiedLineRanges.append(fileChangedTextRange.location ..< NSMaxRange(fileChangedTextRange))
-						}
-					case .deleted:
-						commentChangeColor = style.changeDeletedColor
-						
-						if updateBreadcrumbs && breadcrumbs != nil {
-							breadcrumbs!.fileChangeDeletedLineRanges.append(fileChangedTextRange.location ..< NSMaxRange(fileChangedTextRange))
-						}
-					case .added:
-						commentChangeColor = style.changeAddedColor
-						
-						if updateBreadcrumbs && breadcrumbs != nil {
-							breadcrumbs!.fileChangeAddedLineRanges.append(fileChangedTextRange.location ..< NSMaxRange(fileChangedTextRange))
-						}
-					}
-					
-					let displayAttributes: [NSAttributedString.Key: AnyObject] = [.font: commentFont, .foregroundColor: commentChangeColor]
-					textWithDisplayAttributes.addAttributes(displayAttributes, range: fileChangedTextRange)
+				let commentChangeColor: NSColor
+				switch classification.kind {
+				case .fileModified:
+					commentChangeColor = style.changeModifiedColor
+				case .fileDeleted:
+					commentChangeColor = style.changeDeletedColor
+				case .fileAdded:
+					commentChangeColor = style.changeAddedColor
+				case .content, .overflowingContent, .comment, .commentSectionComment, .commentSectionPlain, .diffHeader, .diffAdd, .diffRemove:
+					commentChangeColor = style.commentColor
 				}
+				
+				let displayAttributes: [NSAttributedString.Key: AnyObject] = [.font: commentFont, .foregroundColor: commentChangeColor]
+				textWithDisplayAttributes.addAttributes(displayAttributes, range: fileChangeRange)
 			} else {
 				let displayAttributes: [NSAttributedString.Key: AnyObject] = [.font: commentFont, .foregroundColor: style.commentColor]
-				textWithDisplayAttributes.addAttributes(displayAttributes, range: NSMakeRange(0, range.length))
-			}
-			
-			if updateBreadcrumbs && !isCommentSection && breadcrumbs != nil {
-				breadcrumbs!.commentLineRanges.append(range.location ..< NSMaxRange(range))
+				textWithDisplayAttributes.addAttributes(displayAttributes, range: fullTextRange)
 			}
-			
-			paragraphWithDisplayAttributes = NSTextParagraph(attributedString: textWithDisplayAttributes)
 		}
 		
-		return paragraphWithDisplayAttributes
+		return NSTextParagraph(attributedString: textWithDisplayAttributes)
 	}
 	
 	func textContentStorage(_ textContentStorage: NSTextContentStorage, textParagraphWith range: NSRange) -> NSTextParagraph? {
 		return newTextParagraph(textContentStorage, range: range, updateBreadcrumbs: false)
 	}
 	
-	@objc func textView(_ textView: NSTextView, shouldSetSpellingState value: Int, range affectedCharRange: NSRange) -> Int {
-		let plainText = currentPlainText()
-		
-		let commentRange = TextProcessor.commentUTF16Range(plainText: plainText, commentSectionLength: commentSectionLength)
+	@objc func textView(_ textView: NSTextView, clickedOnLink link: Any, at charIndex: Int) -> Bool {
+		guard let linkString = link as? String, linkString == COLLAPSED_SCISSORED_CONTENT_LINK else {
+			return false
+		}
 		
+		expandCollapsedScissoredContent()
+		return true
+	}
+	
+	@objc func textView(_ textView: NSTextView, shouldSetSpellingState value: Int, range affectedCharRange: NSRange) -> Int {
 		// Check if affected character range is in the comment section (which includes scissored content)
-		if affectedCharRange.location >= commentRange.location {
+		if affectedCharRange.location >= lineIndex.commentSectionLocation {
 			return 0
 		}
 		
-		guard let affectedRange = Range(affectedCharRange, in: plainText) else {
+		guard let text = textView.textStorage?.mutableString, NSMaxRange(affectedCharRange) <= text.length else {
 			return value
 		}
 		
-		var lineStartIndex = String.Index(utf16Offset: 0, in: plainText)
-		var lineEndIndex = String.Index(utf16Offset: 0, in: plainText)
-		var contentEndIndex = String.Index(utf16Offset: 0, in: plainText)
+		var lineStartIndex = 0
+		var lineEndIndex = 0
+		var contentEndIndex = 0
 		
-		plainText.getLineStart(&lineStartIndex, end: &lineEndIndex, contentsEnd: &contentEndIndex, for: affectedRange)
-		let line = String(plainText[lineStartIndex ..< contentEndIndex])
+		text.getLineStart(&lineStartIndex, end: &lineEndIndex, contentsEnd: &contentEndIndex, for: affectedCharRange)
+		let line = text.substring(with: NSMakeRange(lineStartIndex, contentEndIndex - lineStartIndex))
 		
-		return TextProcessor.isCommentLine(line, versionControlType: commentVersionControlType) ? 0 : value
+		return commentSyntax.isCommentLine(line) ? 0 : value
 	}
 	
 	@objc func textView(_ textView: NSTextView, doCommandBy commandSelector: Selector) -> Bool {
@@ -610,29 +551,27 @@ class ContentViewController: NSViewController, NSTextStorageDelegate, NSTextCont
 		let utf16Range = selectedUTF16Ranges[0]
 		
 		do {
-			let plainText = currentPlainText()
-			guard let range = Range(utf16Range, in: plainText) else {
+			guard let text = textView.textStorage?.mutableString, NSMaxRange(utf16Range) <= text.length else {
 				return false
 			}
 			
-			guard let startContentLineIndex = TextProcessor.firstContentLineIndex(plainText: plainText, versionControlType: commentVersionControlType) else {
+			guard let startContentLineLocation = lineIndex.firstContentLineLocation else {
 				return false
 			}
 			
-			var lineStartIndex = String.Index(utf16Offset: 0, in: plainText)
-			var lineEndIndex = String.Index(utf16Offset: 0, in: plainText)
-			var contentEndIndex = String.Index(utf16Offset: 0, in: plainText)
+			var lineStartIndex = 0
+			var lineEndIndex = 0
+			var contentEndIndex = 0
 			
-			plainText.getLineStart(&lineStartIndex, end: &lineEndIndex, contentsEnd: &contentEndIndex, for: range)
+			text.getLineStart(&lineStartIndex, end: &lineEndIndex, contentsEnd: &contentEndIndex, for: utf16Range)
 			
 			// We must be at the first (subject) line and there must be some content
-			guard lineStartIndex == startContentLineIndex, contentEndIndex > lineStartIndex else {
+			guard lineStartIndex == startContentLineLocation, contentEndIndex > lineStartIndex else {
 				return false
 			}
 			
 			// Line must be at beginning of comment section or must be newline character
-			let utf16View = plainText.utf16
-			guard lineEndIndex == TextProcessor.commentSectionIndex(plainUTF16Text: utf16View, commentSectionLength: commentSectionLength) || plainText[lineEndIndex].isNewline else {
+			guard lineEndIndex == lineIndex.commentSectionLocation || (lineEndIndex < text.length && Unicode.Scalar(text.character(at: lineEndIndex)).map({ CharacterSet.newlines.contains($0) }) ?? false) else {
 				return false
 			}
 		}
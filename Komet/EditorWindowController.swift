@@ -11,6 +11,9 @@ import AppKit
 
 private let ZGEditorWindowFrameNameKey = "ZGEditorWindowFrame"
 private let APP_SUPPORT_DIRECTORY_NAME = "Komet"
+private let COMMENT_SYNTAXES_FILE_NAME = "CommentSyntaxes.json"
+// Amount of collapsed scissored content that is still loaded into the editor
+private let SCISSORED_CONTENT_PREVIEW_LENGTH = 256 * 1024
 
 @objc class ZGEditorWindowController: NSWindowController, UserDefaultsEditorListener {
 	
@@ -18,10 +21,8 @@ private let APP_SUPPORT_DIRECTORY_NAME = "Komet"
 	private let temporaryDirectoryURL: URL?
 	private let tutorialMode: Bool
 	
-	private let initiallyContainedEmptyContent: Bool
-	private let initiallyContainedEmptyCommentIntroLine: Bool
-	private let versionControlType: VersionControlType
-	private let commentVersionControlType: VersionControlType
+	// The commit file is read and parsed in the background while the window is built
+	private let launchPipeline: LaunchPipeline
 	private let projectNameDisplay: String
 	
 	private let versionControlledFile: Bool
@@ -35,6 +36,15 @@ private let APP_SUPPORT_DIRECTORY_NAME = "Komet"
 	private let commitContentViewController: ContentViewController
 	private let horizontalLineDivider: ColoredDivider!
 	
+	// Waits for the commit file to be loaded if it hasn't been yet
+	private var loadedCommit: LoadedCommit {
+		do {
+			return try launchPipeline.wait()
+		} catch {
+			exit(loadError: error)
+		}
+	}
+	
 	// MARK: Static functions
 	
 	private static func styleTheme(defaultTheme: WindowStyleDefaultTheme, effectiveAppearance: NSAppearance) -> WindowStyleTheme {
@@ -73,13 +83,14 @@ private let APP_SUPPORT_DIRECTORY_NAME = "Komet"
 			ZGDisableSpellCheckingAndCorrectionForSquashesKey: true,
 			ZGDisableAutomaticNewlineInsertionAfterSubjectLineForSquashesKey: true,
 			ZGDetectHGCommentStyleForSquashesKey: true,
-			ZGAssumeVersionControlledFileKey: true
+			ZGAssumeVersionControlledFileKey: true,
+			ZGScissoredContentCollapseThresholdKey: 8 * 1024 * 1024
 		])
 		
 		ZGCommitTextView.registerDefaults()
 	}
 	
-	required init(fileURL: URL, temporaryDirectoryURL: URL?, tutorialMode: Bool) {
+	required init(fileURL: URL, temporaryDirectoryURL: URL?, tutorialMode: Bool, launchTrace: LaunchTrace) {
 		self.fileURL = fileURL
 		self.temporaryDirectoryURL = temporaryDirectoryURL
 		self.tutorialMode = tutorialMode
@@ -98,19 +109,6 @@ private let APP_SUPPORT_DIRECTORY_NAME = "Komet"
 		
 		style = WindowStyle.withTheme(Self.styleTheme(defaultTheme: ZGReadDefaultWindowStyleTheme(userDefaults, ZGWindowStyleThemeKey), effectiveAppearance: NSApp.effectiveAppearance))
 		
-		let loadedPlainString: String
-		do {
-			let plainStringCandidate = try String(contentsOf: self.fileURL, encoding: .utf8)
-			
-			// It's unlikely we'll get content that has no line break, but if we do,
-			// just insert a newline character because Komet won't be able to deal with the content otherwise
-			let lineCount = plainStringCandidate.components(separatedBy: .newlines).count
-			loadedPlainString = (lineCount <= 1) ? "\n" : plainStringCandidate
-		} catch {
-			fatalError("Failed to parse commit data: \(error)")
-		}
-		
-		// Detect version control type
 		let fileManager = FileManager()
 		let parentURL = self.fileURL.deletingLastPathComponent()
 		let versionControlledFileFromEnvironment = userDefaults.bool(forKey: ZGAssumeVersionControlledFileKey)
@@ -124,146 +122,49 @@ private let APP_SUPPORT_DIRECTORY_NAME = "Komet"
 			versionControlledFile = true
 		}
 		
-		let versionControlType: VersionControlType
+		// Detect project name
 		if tutorialMode || !versionControlledFile {
-			versionControlType = .git
 			self.projectNameDisplay = self.fileURL.lastPathComponent
 		} else if parentURL.lastPathComponent == ".git" {
-			// We don't *have* to detect this for git because we could look at the current working directory first,
-			// but I want to rely on the current working directory as a last resort.
-			
-			versionControlType = .git
 			self.projectNameDisplay = parentURL.deletingLastPathComponent().lastPathComponent
+		} else if let projectNameFromEnvironment = processInfo.environment[ZGProjectNameKey] {
+			self.projectNameDisplay = projectNameFromEnvironment
 		} else {
-			if self.fileURL.pathExtension == "jjdescription" {
-				versionControlType = .jj
-			} else {
-				let lastPathComponent = self.fileURL.lastPathComponent
-				if lastPathComponent.hasPrefix("hg-") {
-					versionControlType = .hg
-				} else if lastPathComponent.hasPrefix("svn-") {
-					versionControlType = .svn
-				} else {
-					versionControlType = .git
-				}
-			}
-			
-			if let projectNameFromEnvironment = processInfo.environment[ZGProjectNameKey] {
-				self.projectNameDisplay = projectNameFromEnvironment
-			} else {
-				self.projectNameDisplay = URL(fileURLWithPath: fileManager.currentDirectoryPath).lastPathComponent
-			}
+			self.projectNameDisplay = URL(fileURLWithPath: fileManager.currentDirectoryPath).lastPathComponent
 		}
 		
-		self.versionControlType = versionControlType
-		
-		// Detect heuristically if this is a squash/rebase in git or hg
-		// Scan the entire string contents for simplicity and handle both git and hg (with histedit extension)
-		// Also test if the filename contains "rebase"
-		let isSquashMessage: Bool
-		switch versionControlType {
-		case .hg:
-			fallthrough
-		case .git:
-			isSquashMessage = fileURL.lastPathComponent.contains("rebase") || loadedPlainString.contains("= use commit")
-		case .svn:
-			fallthrough
-		case .jj:
-			isSquashMessage = false
-		}
+		let supportDirectory = fileManager.urls(for: .applicationSupportDirectory, in: .userDomainMask).first?.appendingPathComponent(APP_SUPPORT_DIRECTORY_NAME)
 		
-		commentVersionControlType =
-			(isSquashMessage && versionControlType == .hg && userDefaults.bool(forKey: ZGDetectHGCommentStyleForSquashesKey)) ?
-			.git : versionControlType
-		
-		// Detect if there's empty content
-		let loadedCommentSectionLength = !versionControlledFile ? 0 : TextProcessor.commentSectionLength(plainText: loadedPlainString, versionControlType: commentVersionControlType)
-		let loadedCommitRange = TextProcessor.commitTextRange(plainText: loadedPlainString, commentLength: loadedCommentSectionLength)
-		
-		let loadedContent = loadedPlainString[loadedCommitRange.lowerBound ..< loadedCommitRange.upperBound]
-		
-		// Note: Some jj message templates have a comment intro (like 'split')
-		// In these cases, we track these messages as not having empty content initially,
-		// but also track it as initially containing just an intro comment line and nothing else
-		let trimmedLoadedContent = loadedContent.trimmingCharacters(in: .newlines)
-		if trimmedLoadedContent.count == 0 {
-			initiallyContainedEmptyContent = true
-			initiallyContainedEmptyCommentIntroLine = false
-		} else if trimmedLoadedContent.contains(where: { $0.isNewline }) {
-			// There must be more non-empty content after the newline
-			initiallyContainedEmptyContent = false
-			initiallyContainedEmptyCommentIntroLine = false
-		} else {
-			let hasIntroCommentLine = TextProcessor.isCommentLine(trimmedLoadedContent, versionControlType: commentVersionControlType)
-			initiallyContainedEmptyContent = hasIntroCommentLine
-			initiallyContainedEmptyCommentIntroLine = hasIntroCommentLine
-		}
+		var launchOptions = LaunchPipeline.Options()
+		launchOptions.versionControlledFile = versionControlledFile
+		launchOptions.detectsVersionControlType = !tutorialMode && versionControlledFile
+		// Comment syntaxes for version control systems Komet doesn't know about (or for a custom git core.commentChar)
+		// are read from the application support directory
+		launchOptions.customCommentSyntaxesURL = supportDirectory?.appendingPathComponent(COMMENT_SYNTAXES_FILE_NAME)
+		launchOptions.detectHGCommentStyleForSquashes = userDefaults.bool(forKey: ZGDetectHGCommentStyleForSquashesKey)
+		// Large scissored diffs are collapsed so we don't need to load all of it into the editor
+		launchOptions.collapseThreshold = (versionControlledFile && !tutorialMode) ? userDefaults.integer(forKey: ZGScissoredContentCollapseThresholdKey) : 0
+		launchOptions.previewLength = SCISSORED_CONTENT_PREVIEW_LENGTH
 		
 		// Check if we have any incomplete commit message available
-		// Load the incomplete commit message contents if our content is initially empty
-		let lastSavedCommitMessage: String?
+		// It is only loaded if our content is initially empty
 		if !self.tutorialMode && versionControlledFile && userDefaults.bool(forKey: ZGResumeIncompleteSessionKey) {
-			if let applicationSupportURL = fileManager.urls(for: .applicationSupportDirectory, in: .userDomainMask).first {
-				let supportDirectory = applicationSupportURL.appendingPathComponent(APP_SUPPORT_DIRECTORY_NAME)
-				
-				let lastCommitURL = supportDirectory.appendingPathComponent(projectNameDisplay)
+			if let supportDirectory {
+				launchOptions.savedCommitMessageURL = supportDirectory.appendingPathComponent(projectNameDisplay)
 				
-				do {
-					let reachable = try lastCommitURL.checkResourceIsReachable()
-					if reachable {
-						defer {
-							// Always remove the last commit file on every launch
-							let _ = try? fileManager.removeItem(at: lastCommitURL)
-						}
-						
-						let resource = try lastCommitURL.resourceValues(forKeys: [.attributeModificationDateKey])
-						let lastModifiedDate = resource.attributeModificationDate
-						
-						// Use a timeout interval for using the last incomplete commit message
-						// If too much time passes by, chances are the user may want to start anew
-						let maxTimeout = 60.0 * 60.0 * 24 * 7 * 5 // around a month
-						let timeoutInterval = ZGReadDefaultTimeoutInterval(userDefaults, ZGResumeIncompleteSessionTimeoutIntervalKey, maxTimeout)
-						let intervalSinceLastSavedCommitMessage = lastModifiedDate.flatMap({ Date().timeIntervalSince($0) }) ?? 0.0
-						
-						if initiallyContainedEmptyContent && !initiallyContainedEmptyCommentIntroLine && intervalSinceLastSavedCommitMessage >= 0.0 && intervalSinceLastSavedCommitMessage <= timeoutInterval {
-							lastSavedCommitMessage = try String(contentsOf: lastCommitURL, encoding: .utf8)
-						} else {
-							lastSavedCommitMessage = nil
-						}
-					} else {
-						lastSavedCommitMessage = nil
-					}
-				} catch {
-					print("Failed to load last saved commit message: \(error)")
-					lastSavedCommitMessage = nil
-				}
+				let maxTimeout = 60.0 * 60.0 * 24 * 7 * 5 // around a month
+				launchOptions.savedCommitMessageTimeoutInterval = ZGReadDefaultTimeoutInterval(userDefaults, ZGResumeIncompleteSessionTimeoutIntervalKey, maxTimeout)
 			} else {
 				print("Failed to find application support directory")
-				lastSavedCommitMessage = nil
 			}
-		} else {
-			lastSavedCommitMessage = nil
 		}
 		
-		let initialPlainText: String
-		let initialCommitTextRange: Range<String.UTF16View.Index>
-		let resumedFromSavedCommit: Bool
-		let commentSectionLength: Int
-		
-		if let savedCommitMessage = lastSavedCommitMessage {
-			initialPlainText = savedCommitMessage.appending(loadedPlainString)
-			commentSectionLength = !versionControlledFile ? 0 : TextProcessor.commentSectionLength(plainText: initialPlainText, versionControlType: commentVersionControlType)
-			initialCommitTextRange = TextProcessor.commitTextRange(plainText: initialPlainText, commentLength: commentSectionLength)
-			resumedFromSavedCommit = true
-		} else {
-			initialPlainText = loadedPlainString
-			commentSectionLength = loadedCommentSectionLength
-			initialCommitTextRange = loadedCommitRange
-			resumedFromSavedCommit = false
-		}
+		// Reading and parsing the commit file overlaps with building the window and its views
+		// ContentViewController waits for it to finish right before populating its text storage
+		launchPipeline = LaunchPipeline(fileURL: self.fileURL, options: launchOptions, trace: launchTrace)
 		
 		topBarViewController = TopBarViewController()
-		commitContentViewController = ContentViewController(initialPlainText: initialPlainText, commentSectionLength: commentSectionLength, commentVersionControlType: commentVersionControlType, resumedFromSavedCommit: resumedFromSavedCommit, initialCommitTextRange: initialCommitTextRange, isSquashMessage: isSquashMessage, versionControlledFile: versionControlledFile, breadcrumbs: breadcrumbs)
+		commitContentViewController = ContentViewController(launchPipeline: launchPipeline, versionControlledFile: versionControlledFile, breadcrumbs: breadcrumbs)
 		horizontalLineDivider = ColoredDivider()
 		
 		super.init(window: nil)
@@ -314,6 +215,9 @@ private let APP_SUPPORT_DIRECTORY_NAME = "Komet"
 		
 		commitContentViewController.commitHandler = commitHandler
 		commitContentViewController.cancelHandler = cancelHandler
+		commitContentViewController.loadFailureHandler = { [weak self] error in
+			self?.exit(loadError: error)
+		}
 		
 		// Set up views
 		if let contentView = self.window?.contentView {
@@ -392,51 +296,30 @@ private let APP_SUPPORT_DIRECTORY_NAME = "Komet"
 		topBarViewController.updateProjectName(projectNameDisplay)
 		
 		func showBranchName() {
-			let toolName: String
-			let toolArguments: [String]
+			let environment = ProcessInfo.processInfo.environment
+			let workingDirectoryURL = URL(fileURLWithPath: FileManager.default.currentDirectoryPath, isDirectory: true)
 			
-			switch versionControlType {
-			case .git:
-				toolName = "git"
-				toolArguments = ["rev-parse", "--symbolic-full-name", "--abbrev-ref", "HEAD"]
-			case .hg:
-				toolName = "hg"
-				toolArguments = ["branch"]
-			case .svn:
-				return
-			case .jj:
-				return
+			func showProjectName(branchName: String) {
+				let projectNameWithBranch = "\(self.projectNameDisplay) (\(branchName))"
+				self.topBarViewController.updateProjectName(projectNameWithBranch)
 			}
 			
-			if let toolURL = ProcessInfo.processInfo.environment["PATH"]?.components(separatedBy: ":").map({ parentDirectoryPath -> URL in
-				return URL(fileURLWithPath: parentDirectoryPath).appendingPathComponent(toolName)
-			}).first(where: { toolURL -> Bool in
-				let reachable = try? toolURL.checkResourceIsReachable()
-				return reachable ?? false
-			}) {
-				DispatchQueue.global(qos: .userInteractive).async {
-					let process = Process()
-					process.executableURL = toolURL
-					process.arguments = toolArguments
-					
-					let pipe = Pipe()
-					process.standardOutput = pipe
-					
-					do {
-						try process.run()
-						process.waitUntilExit()
-						
-						if process.terminationStatus == EXIT_SUCCESS {
-							let data = pipe.fileHandleForReading.readDataToEndOfFile()
-							if let branchName = String(data: data, encoding: .utf8)?.trimmingCharacters(in: .whitespacesAndNewlines), branchName.count > 0 {
-								DispatchQueue.main.async {
-									let projectNameWithBranch = "\(self.projectNameDisplay) (\(branchName))"
-									self.topBarViewController.updateProjectName(projectNameWithBranch)
-								}
-							}
-						}
-					} catch {
-						print("Failed to retrieve branch name: \(error)")
+			// Reading the repository's files directly is usually cheap, but it can still stall on a slow or network file system
+			// or on a locked svn database, so the branch name is resolved in the background.
+			// We only need to spawn the version control tool in cases the resolver doesn't handle.
+			let versionControlType = loadedCommit.versionControlType
+			DispatchQueue.global(qos: .userInteractive).async {
+				let branchName: String?
+				switch BranchNameResolver.resolve(versionControlType: versionControlType, workingDirectoryURL: workingDirectoryURL, environment: environment) {
+				case .resolved(let resolvedBranchName):
+					branchName = resolvedBranchName
+				case .unresolved:
+					branchName = BranchNameResolver.branchNameFromTool(versionControlType: versionControlType, workingDirectoryURL: workingDirectoryURL, environment: environment)
+				}
+				
+				if let branchName {
+					DispatchQueue.main.async {
+						showProjectName(branchName: branchName)
 					}
 				}
 			}
@@ -446,6 +329,8 @@ private let APP_SUPPORT_DIRECTORY_NAME = "Komet"
 		if !tutorialMode && versionControlledFile {
 			showBranchName()
 		}
+		
+		launchPipeline.trace.mark("Ready")
 	}
 	
 	// MARK: Actions
@@ -472,6 +357,21 @@ private let APP_SUPPORT_DIRECTORY_NAME = "Komet"
 		Darwin.exit(status)
 	}
 	
+	// Komet can't do anything useful with a commit file it fails to read
+	private func exit(loadError error: Error) -> Never {
+		print("Failed to load commit file: \(error)")
+		
+		let alert = NSAlert(error: error)
+		alert.alertStyle = .critical
+		alert.runModal()
+		
+		if let temporaryDirectoryURL = temporaryDirectoryURL {
+			let _ = try? FileManager.default.removeItem(at: temporaryDirectoryURL)
+		}
+		
+		exit(status: EXIT_FAILURE)
+	}
+	
 	func exit(success: Bool) -> Never {
 		self.window?.saveFrame(usingName: ZGEditorWindowFrameNameKey)
 		
@@ -487,14 +387,14 @@ private let APP_SUPPORT_DIRECTORY_NAME = "Komet"
 			if !versionControlledFile {
 				// Non version controlled files don't need a failure exit status
 				exit(status: EXIT_SUCCESS)
-			} else if !initiallyContainedEmptyContent {
+			} else if !loadedCommit.initiallyContainedEmptyContent {
 				// If we're amending an existing commit for example, we should fail and not create another change
 				exit(status: EXIT_FAILURE)
 			} else {
 				// If we initially had no content and wrote an incomplete commit message,
 				// then save the commit message in case we may want to resume from it later
 				let userDefaults = UserDefaults.standard
-				if !initiallyContainedEmptyCommentIntroLine && userDefaults.bool(forKey: ZGResumeIncompleteSessionKey) {
+				if !loadedCommit.initiallyContainedEmptyCommentIntroLine && userDefaults.bool(forKey: ZGResumeIncompleteSessionKey) {
 					let commitMessageContent = commitContentViewController.commitMessageContent()
 					if commitMessageContent.count > 0 {
 						do {
@@ -516,7 +416,7 @@ private let APP_SUPPORT_DIRECTORY_NAME = "Komet"
 				// Some VCS (git, hg) will abort on empty commit messages
 				// In these cases it may be more graceful to exit with status 0,
 				// if there was initially no empty content
-				switch versionControlType {
+				switch loadedCommit.versionControlType {
 				case .hg:
 					fallthrough
 				case .git:
@@ -525,16 +425,20 @@ private let APP_SUPPORT_DIRECTORY_NAME = "Komet"
 					fallthrough
 				case .jj:
 					exit(status: EXIT_FAILURE)
+				case .custom(let commentSyntax):
+					let abortsOnEmptyMessage = (commentSyntax.baseVersionControlType == .git || commentSyntax.baseVersionControlType == .hg)
+					exit(status: abortsOnEmptyMessage ? EXIT_SUCCESS : EXIT_FAILURE)
 				}
 			}
 		}
 	}
 	
 	@IBAction @objc func commit(_ sender: Any?) {
-		let plainText = commitContentViewController.currentPlainText()
+		let commitData = commitContentViewController.commitFileData()
 		
 		do {
-			try plainText.write(to: fileURL, atomically: true, encoding: .utf8)
+			// This must be written atomically because the original commit file may still be memory mapped
+			try commitData.write(to: fileURL, options: .atomic)
 			exit(success: true)
 		} catch {
 			print("Failed to write file for commit: \(error)")
@@ -35,6 +35,8 @@ let ZGDetectHGCommentStyleForSquashesKey = "ZGDetectHGCommentStyleForSquashes"
 
 let ZGAssumeVersionControlledFileKey = "ZGAssumeVersionControlledFile"
 
+let ZGScissoredContentCollapseThresholdKey = "ZGScissoredContentCollapseThreshold"
+
 let ZGCommitTextViewContinuousSpellCheckingKey = "ZGCommitTextViewContinuousSpellChecking"
 let ZGCommitTextViewAutomaticSpellingCorrectionKey = "ZGCommitTextViewAutomaticSpellingCorrection"
 let ZGCommitTextViewAutomaticTextReplacementKey = "ZGCommitTextViewAutomaticTextReplacement"
@@ -0,0 +1,181 @@
+//
+//  main.swift
+//  KometAnalyze
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import Foundation
+import KometCore
+
+// Matches the registered defaults in the app
+private let DEFAULT_COLLAPSE_THRESHOLD = 8 * 1024 * 1024
+private let PREVIEW_LENGTH = 256 * 1024
+private let MAXIMUM_LINE_LIMIT = 1000
+
+private let USAGE = """
+Usage: komet-analyze [options] <commit-file>
+
+Prints the breadcrumbs Komet records for a commit file without launching the editor.
+The file is loaded with the editor's launch pipeline and default settings, and classified like the editor styles it.
+
+Options:
+  --format json|rle              Print breadcrumbs as JSON (default) or line kinds as a run-length encoding
+  --output <path>                Write to a file instead of standard output
+  --subject-limit <count|off>    Subject length limit (default: 69)
+  --body-limit <count|off>       Body line length limit (default: off)
+  --no-file-changes              Don't highlight file changes in the comment section
+  --no-hg-squash-detection       Don't use git comments for hg squash messages
+  --not-version-controlled       Treat the file as a plain text file
+  --collapse-threshold <bytes>   Collapse scissored content larger than this (default: 8388608, 0 to disable)
+  --comment-syntaxes <path>      Read custom comment syntaxes from a file like the editor's CommentSyntaxes.json
+
+Run-length encoding line kinds:
+  t content, o overflowing content, c comment
+  C comment section comment, p comment section plain text
+  h diff header, + diff add, - diff remove
+  M file modified, A file added, D file deleted
+"""
+
+private enum OutputFormat: String {
+	case json
+	case rle
+}
+
+private func exitWithError(_ message: String) -> Never {
+	FileHandle.standardError.write(Data("komet-analyze: \(message)\n".utf8))
+	exit(1)
+}
+
+private func exitWithUsage() -> Never {
+	FileHandle.standardError.write(Data((USAGE + "\n").utf8))
+	exit(2)
+}
+
+private func parseLineLimit(_ argument: String?) -> Int? {
+	guard let argument else {
+		exitWithUsage()
+	}
+
+	if argument == "off" {
+		return nil
+	}
+
+	guard let lineLimit = Int(argument) else {
+		exitWithUsage()
+	}
+
+	// Same clamping as ZGReadDefaultLineLimit()
+	return min(MAXIMUM_LINE_LIMIT, max(lineLimit, 0))
+}
+
+var format = OutputFormat.json
+var outputPath: String? = nil
+var filePath: String? = nil
+var analyzerOptions = BreadcrumbsAnalyzer.Options()
+var detectHGCommentStyleForSquashes = true
+var assumeVersionControlledFile = true
+var collapseThreshold = DEFAULT_COLLAPSE_THRESHOLD
+var customCommentSyntaxesURL: URL? = nil
+
+var argumentIterator = CommandLine.arguments.dropFirst().makeIterator()
+while let argument = argumentIterator.next() {
+	switch argument {
+	case "--format":
+		guard let value = argumentIterator.next(), let outputFormat = OutputFormat(rawValue: value) else {
+			exitWithUsage()
+		}
+		format = outputFormat
+	case "--output":
+		guard let value = argumentIterator.next() else {
+			exitWithUsage()
+		}
+		outputPath = value
+	case "--subject-limit":
+		analyzerOptions.subjectLengthLimit = parseLineLimit(argumentIterator.next())
+	case "--body-limit":
+		analyzerOptions.bodyLineLengthLimit = parseLineLimit(argumentIterator.next())
+	case "--no-file-changes":
+		analyzerOptions.highlightsFileChanges = false
+	case "--no-hg-squash-detection":
+		detectHGCommentStyleForSquashes = false
+	case "--not-version-controlled":
+		assumeVersionControlledFile = false
+	case "--collapse-threshold":
+		guard let value = argumentIterator.next(), let threshold = Int(value), threshold >= 0 else {
+			exitWithUsage()
+		}
+		collapseThreshold = threshold
+	case "--comment-syntaxes":
+		guard let value = argumentIterator.next() else {
+			exitWithUsage()
+		}
+		// The launch pipeline ignores a comment syntaxes file it can't read like the editor does, but it's an error to pass one here
+		let commentSyntaxesURL = URL(fileURLWithPath: value)
+		do {
+			_ = try CustomCommentSyntax.load(contentsOf: commentSyntaxesURL)
+		} catch {
+			exitWithError("failed to read comment syntaxes from \(value): \(error)")
+		}
+		customCommentSyntaxesURL = commentSyntaxesURL
+	case "--help":
+		print(USAGE)
+		exit(0)
+	default:
+		guard !argument.hasPrefix("-"), filePath == nil else {
+			exitWithUsage()
+		}
+		filePath = argument
+	}
+}
+
+guard let filePath else {
+	exitWithUsage()
+}
+
+let fileURL = URL(fileURLWithPath: filePath)
+
+let versionControlledFile = assumeVersionControlledFile && !TextProcessor.isConfigFile(fileURL)
+
+var launchOptions = LaunchPipeline.Options()
+launchOptions.versionControlledFile = versionControlledFile
+launchOptions.detectsVersionControlType = versionControlledFile
+launchOptions.customCommentSyntaxesURL = customCommentSyntaxesURL
+launchOptions.detectHGCommentStyleForSquashes = detectHGCommentStyleForSquashes
+launchOptions.collapseThreshold = versionControlledFile ? collapseThreshold : 0
+launchOptions.previewLength = PREVIEW_LENGTH
+
+let loadedCommit: LoadedCommit
+do {
+	loadedCommit = try LaunchPipeline(fileURL: fileURL, options: launchOptions).wait()
+} catch {
+	exitWithError("failed to load \(filePath): \(error.localizedDescription)")
+}
+
+analyzerOptions.versionControlledFile = versionControlledFile
+analyzerOptions.isSquashMessage = loadedCommit.isSquashMessage
+
+let analysis = BreadcrumbsAnalyzer.analyze(text: loadedCommit.initialPlainText, versionControlType: loadedCommit.commentVersionControlType, commentSectionLength: loadedCommit.commentSectionLength, options: analyzerOptions)
+
+let outputData: Data
+switch format {
+case .json:
+	do {
+		outputData = try JSONEncoder().encode(analysis.breadcrumbs)
+	} catch {
+		exitWithError("failed to encode breadcrumbs: \(error)")
+	}
+case .rle:
+	outputData = Data((CommitLineKind.runLengthEncoded(analysis.lineKinds) + "\n").utf8)
+}
+
+if let outputPath {
+	do {
+		try outputData.write(to: URL(fileURLWithPath: outputPath), options: .atomic)
+	} catch {
+		exitWithError("failed to write \(outputPath): \(error)")
+	}
+} else {
+	FileHandle.standardOutput.write(outputData)
+}
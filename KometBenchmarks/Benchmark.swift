@@ -0,0 +1,140 @@
+//
+//  Benchmark.swift
+//  KometBenchmarks
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import Foundation
+#if canImport(Darwin)
+import Darwin
+#elseif canImport(Glibc)
+import Glibc
+#endif
+
+// Heap usage as reported by the system allocator.
+// On macOS this covers every malloc zone in the process. glibc only reports its main arena,
+// which misses allocations made on other threads, such as GCD's worker threads.
+struct HeapStatistics {
+	let bytesInUse: Int
+	// Not available from glibc
+	let blocksInUse: Int?
+
+#if canImport(Darwin)
+	static let scope = "process"
+#else
+	static let scope = "main arena"
+#endif
+
+	static func current() -> HeapStatistics {
+#if canImport(Darwin)
+		var statistics = malloc_statistics_t()
+		malloc_zone_statistics(nil, &statistics)
+		return HeapStatistics(bytesInUse: Int(statistics.size_in_use), blocksInUse: Int(statistics.blocks_in_use))
+#elseif canImport(Glibc)
+		return HeapStatistics(bytesInUse: Int(mallinfo2().uordblks), blocksInUse: nil)
+#else
+		return HeapStatistics(bytesInUse: 0, blocksInUse: nil)
+#endif
+	}
+}
+
+struct BenchmarkResult: Encodable {
+	let input: String
+	let function: String
+	// Number of bytes processed per iteration, if throughput is meaningful for the function
+	let byteCount: Int?
+	let iterations: Int
+	let bestSeconds: Double
+	let medianSeconds: Double
+	// Change in heap usage across one extra run while its result is still alive, if it was sampled.
+	// This is a coarse process-wide (or on Linux, main arena only) figure rather than what the function allocates:
+	// it includes anything other threads allocate or free meanwhile, and misses allocations freed before the run returns.
+	let heapChangeBytes: Int?
+	// Change in the number of heap blocks, which isn't available from glibc
+	let heapChangeBlocks: Int?
+	// What the heap figures cover, see HeapStatistics
+	let heapScope: String?
+
+	var megabytesPerSecond: Double? {
+		return byteCount.map({ Double($0) / bestSeconds / 1_000_000 })
+	}
+}
+
+struct BenchmarkRunner {
+	let maximumIterations: Int
+	// Keep running iterations (up to maximumIterations) until this much time has been spent
+	let minimumDuration: Double
+
+	private(set) var results: [BenchmarkResult] = []
+
+	init(maximumIterations: Int, minimumDuration: Double) {
+		self.maximumIterations = maximumIterations
+		self.minimumDuration = minimumDuration
+	}
+
+	// Measures body and returns its last result so it can be validated
+	mutating func measure<Result>(input: String, function: String, byteCount: Int?, _ body: () -> Result) -> Result {
+		var times: [Double] = []
+		var totalTime = 0.0
+		while times.isEmpty || (times.count < maximumIterations && totalTime < minimumDuration) {
+			let startTime = DispatchTime.now().uptimeNanoseconds
+			let result = body()
+			let endTime = DispatchTime.now().uptimeNanoseconds
+			withExtendedLifetime(result) {}
+
+			let time = Double(endTime - startTime) / 1_000_000_000
+			times.append(time)
+			totalTime += time
+		}
+
+		// Run one more time outside of timing to sample the heap while the result is still alive
+		let heapBefore = HeapStatistics.current()
+		let result = body()
+		let heapAfter = HeapStatistics.current()
+
+		let heapChangeBlocks: Int?
+		if let blocksAfter = heapAfter.blocksInUse, let blocksBefore = heapBefore.blocksInUse {
+			heapChangeBlocks = blocksAfter - blocksBefore
+		} else {
+			heapChangeBlocks = nil
+		}
+
+		let sortedTimes = times.sorted()
+		results.append(BenchmarkResult(input: input, function: function, byteCount: byteCount, iterations: times.count, bestSeconds: sortedTimes[0], medianSeconds: sortedTimes[sortedTimes.count / 2], heapChangeBytes: heapAfter.bytesInUse - heapBefore.bytesInUse, heapChangeBlocks: heapChangeBlocks, heapScope: HeapStatistics.scope))
+
+		return result
+	}
+
+	// Records times measured elsewhere, like the stages of a launch that run concurrently
+	mutating func record(input: String, function: String, byteCount: Int?, times: [Double]) {
+		let sortedTimes = times.sorted()
+		results.append(BenchmarkResult(input: input, function: function, byteCount: byteCount, iterations: times.count, bestSeconds: sortedTimes[0], medianSeconds: sortedTimes[sortedTimes.count / 2], heapChangeBytes: nil, heapChangeBlocks: nil, heapScope: nil))
+	}
+}
+
+extension BenchmarkResult {
+	// Signed, since the heap can shrink while a function runs
+	static func formattedByteCount(_ byteCount: Int) -> String {
+		let magnitude = abs(byteCount)
+		if magnitude >= 1024 * 1024 {
+			return String(format: "%+.1f MB", Double(byteCount) / (1024 * 1024))
+		} else if magnitude >= 1024 {
+			return String(format: "%+.1f KB", Double(byteCount) / 1024)
+		} else {
+			return String(format: "%+ld B", byteCount)
+		}
+	}
+
+	var formattedRow: String {
+		let timeDescription = String(format: "%10.3f ms", bestSeconds * 1000)
+		let throughputDescription = megabytesPerSecond.map({ String(format: "%10.1f MB/s", $0) }) ?? String(repeating: " ", count: 10) + "    -"
+		let blocksDescription = heapChangeBlocks.map({ String(format: " %+ld blocks", $0) }) ?? ""
+		let heapDescription = heapChangeBytes.map({ "   \(heapScope ?? "heap") heap \(Self.formattedByteCount($0))" }) ?? ""
+
+		let paddedInput = input.padding(toLength: 28, withPad: " ", startingAt: 0)
+		let paddedFunction = function.padding(toLength: 30, withPad: " ", startingAt: 0)
+		return "\(paddedInput) \(paddedFunction) \(timeDescription) \(throughputDescription)\(heapDescription)\(blocksDescription)"
+	}
+}
@@ -0,0 +1,274 @@
+//
+//  main.swift
+//  KometBenchmarks
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import Foundation
+import KometCore
+import KometTestSupport
+
+// Matches the registered defaults in the app
+private let COLLAPSE_THRESHOLD = 8 * 1024 * 1024
+private let PREVIEW_LENGTH = 256 * 1024
+private let DETECT_HG_COMMENT_STYLE_FOR_SQUASHES = true
+
+private let SYNTHETIC_BYTE_COUNTS = [1024, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024, 100 * 1024 * 1024]
+
+// Every line is measured against length limits for files up to this size, like typing in a long body would.
+// Most synthetic lines fit in 72 characters while most overflow 16 characters, which measures the slower path.
+private let LINE_MEASUREMENT_MAXIMUM_BYTE_COUNT = 16 * 1024 * 1024
+private let LINE_LENGTH_LIMITS = [16, 72]
+
+private let USAGE = """
+Usage: KometBenchmarks [options]
+
+Benchmarks KometCore against synthetic commit files.
+Also measures the time until a launch has loaded the commit file and how long each of its stages takes,
+and compares resolving branch names from repository files against asking git and hg, if they are installed.
+Correctness is checked by the KometCoreTests target instead, which is run with `swift test`.
+
+Options:
+  --max-size <size>            Largest synthetic commit file to generate (default: 100MB)
+  --reference-max-size <size>  Largest file to time the original String based implementation on (default: 1MB)
+  --iterations <count>         Maximum iterations per measurement (default: 10)
+  --json                       Print results as JSON instead of a table
+"""
+
+private func exitWithUsage() -> Never {
+	FileHandle.standardError.write(Data((USAGE + "\n").utf8))
+	exit(2)
+}
+
+// Parses sizes like 512, 64KB, or 16MB
+private func parseByteCount(_ argument: String) -> Int? {
+	let uppercasedArgument = argument.uppercased()
+	if uppercasedArgument.hasSuffix("MB") {
+		return Int(uppercasedArgument.dropLast(2)).map({ $0 * 1024 * 1024 })
+	} else if uppercasedArgument.hasSuffix("KB") {
+		return Int(uppercasedArgument.dropLast(2)).map({ $0 * 1024 })
+	} else {
+		return Int(uppercasedArgument)
+	}
+}
+
+private func commentSectionText(_ text: String, commentSectionLength: Int) -> String {
+	let commentSectionIndex = TextProcessor.commentSectionIndex(plainUTF16Text: text.utf16, commentSectionLength: commentSectionLength)
+	return String(text[commentSectionIndex...])
+}
+
+// Measures every line with each length limit, including its line break like the editor's paragraphs
+private func benchmarkLineMeasurement(name: String, text: NSString, lineIndex: CommitLineIndex, runner: inout BenchmarkRunner, measuresReference: Bool) {
+	let lines = (0 ..< lineIndex.lineCount).map({ lineNumber -> String in
+		let lineStart = lineIndex.lineStart(at: lineNumber)
+		let lineEnd = (lineNumber + 1 < lineIndex.lineCount) ? lineIndex.lineStart(at: lineNumber + 1) : lineIndex.length
+		return text.substring(with: NSMakeRange(lineStart, lineEnd - lineStart))
+	})
+	let byteCount = lines.reduce(0, { $0 + $1.utf8.count })
+
+	for lengthLimit in LINE_LENGTH_LIMITS {
+		_ = runner.measure(input: name, function: "LineMeasurement.overflow/\(lengthLimit)", byteCount: byteCount) {
+			return lines.map({ LineMeasurement.overflowUTF16Range(line: $0, lengthLimit: lengthLimit) })
+		}
+
+		if measuresReference {
+			_ = runner.measure(input: name, function: "Reference.overflow/\(lengthLimit)", byteCount: byteCount) {
+				return lines.map({ ReferenceTextProcessor.overflowUTF16Range(line: $0, lengthLimit: lengthLimit) })
+			}
+		}
+	}
+}
+
+private func benchmark(_ commit: SyntheticCommit, in directoryURL: URL, launchOptions: LaunchPipeline.Options, runner: inout BenchmarkRunner, measuresReference: Bool) throws {
+	let name = commit.name
+	let text = commit.text
+	let byteCount = text.utf8.count
+	let versionControlType = commit.versionControlType
+
+	let fileURL = directoryURL.appendingPathComponent(commit.fileName)
+	try Data(text.utf8).write(to: fileURL)
+	defer {
+		try? FileManager.default.removeItem(at: fileURL)
+	}
+
+	let commitFile = try CommitFile(contentsOf: fileURL)
+
+	_ = runner.measure(input: name, function: "CommitFile.loadText", byteCount: byteCount) {
+		return commitFile.loadText(versionControlType: versionControlType, collapseThreshold: COLLAPSE_THRESHOLD, previewLength: PREVIEW_LENGTH, placeholder: { collapsedByteCount in
+			return TextProcessor.commentLine(CollapsedScissoredContent.placeholderDescription(collapsedByteCount: collapsedByteCount), versionControlType: versionControlType)
+		})
+	}
+
+	let scan = runner.measure(input: name, function: "TextProcessor.scanCommitText", byteCount: byteCount) {
+		return TextProcessor.scanCommitText(plainText: text, versionControlType: versionControlType)
+	}
+
+	_ = runner.measure(input: name, function: "TextProcessor.firstContentLine", byteCount: byteCount) {
+		return TextProcessor.firstContentLineIndex(plainText: text, versionControlType: versionControlType)
+	}
+
+	if measuresReference {
+		_ = runner.measure(input: name, function: "Reference.commentSectionLength", byteCount: byteCount) {
+			return ReferenceTextProcessor.commentSectionLength(plainText: text, versionControlType: versionControlType)
+		}
+	}
+
+	let nsText = NSString(string: text)
+	let lineIndex = runner.measure(input: name, function: "CommitLineIndex.init", byteCount: byteCount) {
+		return CommitLineIndex(text: nsText, versionControlType: versionControlType, commentSectionLength: scan.commentSectionLength)
+	}
+
+	// Only the line index update is measured, not the edit to the text
+	let editedText = NSMutableString(string: text)
+	editedText.insert("a\n", at: 0)
+	_ = runner.measure(input: name, function: "CommitLineIndex.textDidChange", byteCount: nil) { () -> CommitLineIndex in
+		var editedLineIndex = lineIndex
+		editedLineIndex.textDidChange(editedText, editedRange: NSMakeRange(0, 2), changeInLength: 2)
+		return editedLineIndex
+	}
+
+	let commentText = commentSectionText(text, commentSectionLength: scan.commentSectionLength)
+	_ = runner.measure(input: name, function: "CommentSectionHighlights.init", byteCount: commentText.utf8.count) {
+		return CommentSectionHighlights(commentSectionText: commentText, versionControlType: versionControlType)
+	}
+
+	_ = runner.measure(input: name, function: "BreadcrumbsAnalyzer.analyze", byteCount: byteCount) {
+		return BreadcrumbsAnalyzer.analyze(text: text, versionControlType: versionControlType, commentSectionLength: scan.commentSectionLength, options: BreadcrumbsAnalyzer.Options())
+	}
+
+	if byteCount <= LINE_MEASUREMENT_MAXIMUM_BYTE_COUNT {
+		benchmarkLineMeasurement(name: name, text: nsText, lineIndex: lineIndex, runner: &runner, measuresReference: measuresReference)
+	}
+
+	// Time until the editor could populate its text storage, for the stages it runs in the background while building its window
+	var launchTraces: [LaunchTrace] = []
+	let launchResult = runner.measure(input: name, function: "LaunchPipeline.wait", byteCount: byteCount) { () -> Result<LoadedCommit, Error> in
+		let launchTrace = LaunchTrace()
+		launchTraces.append(launchTrace)
+		return Result(catching: {
+			return try LaunchPipeline(fileURL: fileURL, options: launchOptions, trace: launchTrace).wait()
+		})
+	}
+	_ = try launchResult.get()
+
+	// The last trace is from sampling the heap rather than a timed iteration
+	var stageTimes: [String: [Double]] = [:]
+	for launchTrace in launchTraces.dropLast() {
+		for interval in launchTrace.intervals {
+			stageTimes[interval.stage, default: []].append(interval.duration / 1000)
+		}
+	}
+	for (stage, times) in stageTimes.sorted(by: { $0.key < $1.key }) {
+		runner.record(input: name, function: "Launch/\(stage)", byteCount: nil, times: times)
+	}
+}
+
+// Compares how long resolving the branch name from repository files takes with how long asking git or hg takes when launching
+private func benchmarkBranchNames(in directoryURL: URL, runner: inout BenchmarkRunner) {
+	// Don't let the environment the benchmarks are run from point the resolver or tools at another repository
+	let environment = ProcessInfo.processInfo.environment.filter({ !$0.key.hasPrefix("GIT_") })
+
+	for versionControlType in [VersionControlType.git, .hg] {
+		guard let repository = ToolRepositoryFixture.create(versionControlType: versionControlType, in: directoryURL) else {
+			continue
+		}
+
+		_ = runner.measure(input: repository.name, function: "BranchNameResolver.resolve", byteCount: nil) {
+			return BranchNameResolver.resolve(versionControlType: versionControlType, workingDirectoryURL: repository.workingDirectoryURL, environment: environment)
+		}
+
+		_ = runner.measure(input: repository.name, function: "BranchNameResolver.fromTool", byteCount: nil) {
+			return BranchNameResolver.branchNameFromTool(versionControlType: versionControlType, workingDirectoryURL: repository.workingDirectoryURL, environment: environment)
+		}
+	}
+}
+
+// MARK: Main
+
+var maximumByteCount = 100 * 1024 * 1024
+var referenceMaximumByteCount = 1024 * 1024
+var maximumIterations = 10
+var printsJSON = false
+
+var argumentIterator = CommandLine.arguments.dropFirst().makeIterator()
+while let argument = argumentIterator.next() {
+	switch argument {
+	case "--max-size":
+		guard let value = argumentIterator.next(), let byteCount = parseByteCount(value) else {
+			exitWithUsage()
+		}
+		maximumByteCount = byteCount
+	case "--reference-max-size":
+		guard let value = argumentIterator.next(), let byteCount = parseByteCount(value) else {
+			exitWithUsage()
+		}
+		referenceMaximumByteCount = byteCount
+	case "--iterations":
+		guard let value = argumentIterator.next(), let iterations = Int(value), iterations > 0 else {
+			exitWithUsage()
+		}
+		maximumIterations = iterations
+	case "--json":
+		printsJSON = true
+	case "--help":
+		print(USAGE)
+		exit(0)
+	default:
+		exitWithUsage()
+	}
+}
+
+let temporaryDirectoryURL = FileManager.default.temporaryDirectory.appendingPathComponent("KometBenchmarks-\(UUID().uuidString)")
+do {
+	try FileManager.default.createDirectory(at: temporaryDirectoryURL, withIntermediateDirectories: true)
+} catch {
+	FileHandle.standardError.write(Data("Failed to create temporary directory: \(error)\n".utf8))
+	exit(1)
+}
+
+// Launches read the comment syntaxes file like the editor does
+let customCommentSyntaxesURL = temporaryDirectoryURL.appendingPathComponent("CommentSyntaxes.json")
+do {
+	try Data(SyntheticCommit.customCommentSyntaxesJSON.utf8).write(to: customCommentSyntaxesURL)
+} catch {
+	FileHandle.standardError.write(Data("Failed to write custom comment syntaxes: \(error)\n".utf8))
+	exit(1)
+}
+
+var launchOptions = LaunchPipeline.Options()
+launchOptions.customCommentSyntaxesURL = customCommentSyntaxesURL
+launchOptions.detectHGCommentStyleForSquashes = DETECT_HG_COMMENT_STYLE_FOR_SQUASHES
+launchOptions.collapseThreshold = COLLAPSE_THRESHOLD
+launchOptions.previewLength = PREVIEW_LENGTH
+
+var runner = BenchmarkRunner(maximumIterations: maximumIterations, minimumDuration: 0.1)
+for versionControlType in SyntheticCommit.versionControlTypes {
+	for variant in SyntheticCommitVariant.allCases {
+		for targetByteCount in SYNTHETIC_BYTE_COUNTS where targetByteCount <= maximumByteCount {
+			let commit = SyntheticCommit(versionControlType: versionControlType, variant: variant, targetByteCount: targetByteCount)
+			do {
+				try benchmark(commit, in: temporaryDirectoryURL, launchOptions: launchOptions, runner: &runner, measuresReference: targetByteCount <= referenceMaximumByteCount)
+			} catch {
+				FileHandle.standardError.write(Data("\(commit.name): \(error)\n".utf8))
+				try? FileManager.default.removeItem(at: temporaryDirectoryURL)
+				exit(1)
+			}
+		}
+	}
+}
+
+benchmarkBranchNames(in: temporaryDirectoryURL, runner: &runner)
+
+try? FileManager.default.removeItem(at: temporaryDirectoryURL)
+
+if printsJSON {
+	let encoder = JSONEncoder()
+	encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+	print(String(decoding: try! encoder.encode(runner.results), as: UTF8.self))
+} else {
+	for result in runner.results {
+		print(result.formattedRow)
+	}
+}
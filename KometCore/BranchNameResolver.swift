@@ -0,0 +1,391 @@
+//
+//  BranchNameResolver.swift
+//  Komet
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import Foundation
+#if canImport(SQLite3)
+import SQLite3
+#endif
+
+public enum BranchNameResolution: Equatable {
+	// nil if there is no branch name to show (e.g. a git branch that has no commits yet)
+	case resolved(String?)
+	// The repository couldn't be read directly, so the version control tool needs to be asked instead
+	case unresolved
+}
+
+// Resolves the branch name shown next to the project name by reading the repository's files directly,
+// which is much cheaper than spawning git or hg when launching.
+// Anything that isn't understood (e.g. ambiguous ref names or the reftable backend) is left .unresolved
+// rather than guessed, so that branchNameFromTool() can provide the answer.
+public struct BranchNameResolver {
+	public static func resolve(versionControlType: VersionControlType, workingDirectoryURL: URL, environment: [String: String]) -> BranchNameResolution {
+		let workingDirectoryPath = workingDirectoryURL.standardizedFileURL.path
+		switch versionControlType {
+		case .git:
+			return resolveGitBranchName(workingDirectoryPath: workingDirectoryPath, environment: environment)
+		case .hg:
+			return resolveHGBranchName(workingDirectoryPath: workingDirectoryPath)
+		case .svn:
+			return resolveSVNBranchName(workingDirectoryPath: workingDirectoryPath)
+		case .jj:
+			// jj doesn't keep anything resembling a current branch in a file that is cheap to read
+			return .resolved(nil)
+		case .custom(let commentSyntax):
+			guard let baseVersionControlType = commentSyntax.baseVersionControlType else {
+				return .resolved(nil)
+			}
+			return resolve(versionControlType: baseVersionControlType, workingDirectoryURL: workingDirectoryURL, environment: environment)
+		}
+	}
+
+	// Asks the version control tool for the branch name, which can take a while for large repositories
+	public static func branchNameFromTool(versionControlType: VersionControlType, workingDirectoryURL: URL, environment: [String: String]) -> String? {
+		let toolName: String
+		let toolArguments: [String]
+
+		switch versionControlType {
+		case .git:
+			toolName = "git"
+			toolArguments = ["rev-parse", "--symbolic-full-name", "--abbrev-ref", "HEAD"]
+		case .hg:
+			toolName = "hg"
+			toolArguments = ["branch"]
+		case .svn:
+			return nil
+		case .jj:
+			return nil
+		case .custom(let commentSyntax):
+			guard let baseVersionControlType = commentSyntax.baseVersionControlType else {
+				return nil
+			}
+			return branchNameFromTool(versionControlType: baseVersionControlType, workingDirectoryURL: workingDirectoryURL, environment: environment)
+		}
+
+		guard let toolURL = environment["PATH"]?.components(separatedBy: ":").map({ parentDirectoryPath -> URL in
+			return URL(fileURLWithPath: parentDirectoryPath).appendingPathComponent(toolName)
+		}).first(where: { toolURL -> Bool in
+			let reachable = try? toolURL.checkResourceIsReachable()
+			return reachable ?? false
+		}) else {
+			return nil
+		}
+
+		let process = Process()
+		process.executableURL = toolURL
+		process.arguments = toolArguments
+		process.currentDirectoryURL = workingDirectoryURL
+
+		let pipe = Pipe()
+		process.standardOutput = pipe
+
+		do {
+			try process.run()
+			process.waitUntilExit()
+
+			guard process.terminationStatus == EXIT_SUCCESS else {
+				return nil
+			}
+
+			let data = pipe.fileHandleForReading.readDataToEndOfFile()
+			guard let branchName = String(data: data, encoding: .utf8)?.trimmingCharacters(in: .whitespacesAndNewlines), branchName.count > 0 else {
+				return nil
+			}
+			return branchName
+		} catch {
+			print("Failed to retrieve branch name: \(error)")
+			return nil
+		}
+	}
+
+	// MARK: git
+
+	// Matches the output of git rev-parse --symbolic-full-name --abbrev-ref HEAD
+	private static func resolveGitBranchName(workingDirectoryPath: String, environment: [String: String]) -> BranchNameResolution {
+		let gitDirectoryPath: String
+		if let gitDirectoryFromEnvironment = environment["GIT_DIR"] {
+			gitDirectoryPath = absolutePath(gitDirectoryFromEnvironment, relativeTo: workingDirectoryPath)
+		} else {
+			// Ceiling directories change where git stops looking for a repository
+			guard environment["GIT_CEILING_DIRECTORIES"] == nil, environment["GIT_DISCOVERY_ACROSS_FILESYSTEM"] == nil, let discoveredGitDirectoryPath = discoverGitDirectory(from: workingDirectoryPath) else {
+				return .unresolved
+			}
+			gitDirectoryPath = discoveredGitDirectoryPath
+		}
+
+		// git refuses to read repositories owned by other users unless they are marked as safe
+		guard let gitDirectoryStatus = fileStatus(gitDirectoryPath), gitDirectoryStatus.st_uid == getuid() else {
+			return .unresolved
+		}
+
+		// Linked worktrees have their own HEAD but share refs with the main repository
+		let commonDirectoryPath: String
+		if let commonDirectoryFromEnvironment = environment["GIT_COMMON_DIR"] {
+			commonDirectoryPath = absolutePath(commonDirectoryFromEnvironment, relativeTo: workingDirectoryPath)
+		} else if let commonDirectoryFromFile = readFirstLine(path: gitDirectoryPath + "/commondir") {
+			commonDirectoryPath = absolutePath(commonDirectoryFromFile, relativeTo: gitDirectoryPath)
+		} else {
+			commonDirectoryPath = gitDirectoryPath
+		}
+
+		// Refs aren't stored as files with the reftable backend
+		guard fileStatus(commonDirectoryPath + "/reftable") == nil, let head = readFirstLine(path: gitDirectoryPath + "/HEAD") else {
+			return .unresolved
+		}
+
+		let symbolicRefPrefix = "ref: "
+		guard head.hasPrefix(symbolicRefPrefix) else {
+			// git abbreviates a detached HEAD to HEAD
+			return isObjectName(head) ? .resolved("HEAD") : .unresolved
+		}
+
+		let refName = head.dropFirst(symbolicRefPrefix.count).trimmingCharacters(in: .whitespaces)
+		let branchRefPrefix = "refs/heads/"
+		guard refName.hasPrefix(branchRefPrefix) else {
+			return .unresolved
+		}
+
+		let packedRefs = PackedRefs(path: commonDirectoryPath + "/packed-refs")
+
+		switch refState(refName, gitDirectoryPath: commonDirectoryPath, packedRefs: packedRefs) {
+		case .exists:
+			break
+		case .missing:
+			// This is a branch with no commits yet, which git fails to resolve
+			return .resolved(nil)
+		case .unknown:
+			return .unresolved
+		}
+
+		// git uses a longer name if the short name could also refer to another ref (e.g. a tag or a remote with the same name)
+		// These are the ref rev-parse rules other than refs/heads/ itself, which rev-parse checks strictly
+		// See shorten_unambiguous_ref() in git's refs.c
+		let shortName = String(refName.dropFirst(branchRefPrefix.count))
+		for ambiguousRefName in [shortName, "refs/\(shortName)", "refs/tags/\(shortName)", "refs/remotes/\(shortName)", "refs/remotes/\(shortName)/HEAD"] {
+			for directoryPath in Set([gitDirectoryPath, commonDirectoryPath]) {
+				if refState(ambiguousRefName, gitDirectoryPath: directoryPath, packedRefs: packedRefs) != .missing {
+					return .unresolved
+				}
+			}
+		}
+
+		return .resolved(shortName)
+	}
+
+	// Walks up from the working directory like git does to find the repository's git directory,
+	// following "gitdir: <path>" files used by linked worktrees and submodules
+	private static func discoverGitDirectory(from workingDirectoryPath: String) -> String? {
+		guard let workingDirectoryStatus = fileStatus(workingDirectoryPath) else {
+			return nil
+		}
+
+		var directoryPath = workingDirectoryPath
+		while true {
+			let dotGitPath = NSString(string: directoryPath).appendingPathComponent(".git")
+			if let dotGitStatus = fileStatus(dotGitPath) {
+				if isDirectory(dotGitStatus) {
+					return isGitDirectory(dotGitPath) ? dotGitPath : nil
+				}
+
+				let gitDirectoryPrefix = "gitdir: "
+				guard let gitFileLine = readFirstLine(path: dotGitPath), gitFileLine.hasPrefix(gitDirectoryPrefix) else {
+					return nil
+				}
+
+				let gitDirectoryPath = absolutePath(String(gitFileLine.dropFirst(gitDirectoryPrefix.count)), relativeTo: directoryPath)
+				return isGitDirectory(gitDirectoryPath) ? gitDirectoryPath : nil
+			}
+
+			// The directory may itself be a git directory, like a bare repository
+			if isGitDirectory(directoryPath) {
+				return directoryPath
+			}
+
+			// git stops looking at file system boundaries
+			let parentDirectoryPath = NSString(string: directoryPath).deletingLastPathComponent
+			guard parentDirectoryPath != directoryPath, let parentDirectoryStatus = fileStatus(parentDirectoryPath), parentDirectoryStatus.st_dev == workingDirectoryStatus.st_dev else {
+				return nil
+			}
+
+			directoryPath = parentDirectoryPath
+		}
+	}
+
+	private static func isGitDirectory(_ path: String) -> Bool {
+		guard fileStatus(path + "/HEAD") != nil else {
+			return false
+		}
+		return fileStatus(path + "/commondir") != nil || fileStatus(path + "/objects").map(isDirectory) ?? false
+	}
+
+	private static func isObjectName(_ string: String) -> Bool {
+		// SHA-1 or SHA-256 object names
+		return (string.utf8.count == 40 || string.utf8.count == 64) && string.utf8.allSatisfy({ (UInt8(ascii: "0") ... UInt8(ascii: "9")).contains($0) || (UInt8(ascii: "a") ... UInt8(ascii: "f")).contains($0) })
+	}
+
+	private enum RefState {
+		case exists
+		case missing
+		// e.g. a symbolic ref or a file that isn't a ref
+		case unknown
+	}
+
+	private static func refState(_ refName: String, gitDirectoryPath: String, packedRefs: PackedRefs) -> RefState {
+		let refPath = gitDirectoryPath + "/" + refName
+		// A directory (like refs/remotes/origin) isn't a loose ref, but the ref could still be packed
+		if let refStatus = fileStatus(refPath), !isDirectory(refStatus) {
+			guard let refContents = readFirstLine(path: refPath), isObjectName(refContents) else {
+				return .unknown
+			}
+			return .exists
+		}
+
+		return packedRefs.contains(refName) ? .exists : .missing
+	}
+
+	// packed-refs can be large in repositories with many tags, so it is memory mapped and searched
+	// for the ref names we need rather than parsed
+	private struct PackedRefs {
+		private let data: Data?
+
+		init(path: String) {
+			data = try? Data(contentsOf: URL(fileURLWithPath: path), options: .mappedIfSafe)
+		}
+
+		// Lines are formatted as "<object name> <ref name>\n", optionally followed by a "^<peeled object name>\n" line
+		func contains(_ refName: String) -> Bool {
+			guard let data else {
+				return false
+			}
+			return data.range(of: Data(" \(refName)\n".utf8)) != nil
+		}
+	}
+
+	// MARK: hg
+
+	// Matches the output of hg branch, which reads the working directory's branch from .hg/branch
+	private static func resolveHGBranchName(workingDirectoryPath: String) -> BranchNameResolution {
+		guard let repositoryPath = findAncestorDirectory(containing: ".hg", from: workingDirectoryPath) else {
+			return .unresolved
+		}
+
+		let hgDirectoryPath = NSString(string: repositoryPath).appendingPathComponent(".hg")
+		let branchPath = hgDirectoryPath + "/branch"
+		guard fileStatus(branchPath) != nil else {
+			// Working directories that have never switched branches don't have a branch file
+			return .resolved("default")
+		}
+
+		guard let branchName = readFirstLine(path: branchPath) else {
+			return .unresolved
+		}
+		return .resolved(branchName.isEmpty ? "default" : branchName)
+	}
+
+	// MARK: svn
+
+	// svn doesn't have branches, but by convention the working copy's location in the repository tells us the branch
+	private static func resolveSVNBranchName(workingDirectoryPath: String) -> BranchNameResolution {
+#if canImport(SQLite3)
+		guard let workingCopyPath = findAncestorDirectory(containing: ".svn", from: workingDirectoryPath) else {
+			return .resolved(nil)
+		}
+
+		let databasePath = NSString(string: workingCopyPath).appendingPathComponent(".svn") + "/wc.db"
+
+		var database: OpaquePointer? = nil
+		guard sqlite3_open_v2(databasePath, &database, SQLITE_OPEN_READONLY, nil) == SQLITE_OK else {
+			sqlite3_close(database)
+			return .resolved(nil)
+		}
+		defer {
+			sqlite3_close(database)
+		}
+
+		// svn may be holding a write lock while it waits for the commit message
+		sqlite3_busy_timeout(database, 50)
+
+		var statement: OpaquePointer? = nil
+		guard sqlite3_prepare_v2(database, "SELECT repos_path FROM nodes WHERE local_relpath = '' AND op_depth = 0 LIMIT 1", -1, &statement, nil) == SQLITE_OK else {
+			return .resolved(nil)
+		}
+		defer {
+			sqlite3_finalize(statement)
+		}
+
+		guard sqlite3_step(statement) == SQLITE_ROW, let repositoryPathText = sqlite3_column_text(statement, 0) else {
+			return .resolved(nil)
+		}
+
+		return .resolved(svnBranchName(repositoryPath: String(cString: repositoryPathText)))
+#else
+		return .resolved(nil)
+#endif
+	}
+
+	// Finds the branch in paths like "trunk", "project/branches/feature", or "tags/1.0/src"
+	private static func svnBranchName(repositoryPath: String) -> String? {
+		let components = repositoryPath.split(separator: "/")
+		for (index, component) in components.enumerated() {
+			switch component {
+			case "trunk":
+				return "trunk"
+			case "branches", "tags":
+				if index + 1 < components.count {
+					return String(components[index + 1])
+				}
+			default:
+				break
+			}
+		}
+		return nil
+	}
+
+	// MARK: File Helpers
+
+	private static func findAncestorDirectory(containing name: String, from directoryPath: String) -> String? {
+		var currentDirectoryPath = directoryPath
+		while true {
+			if let status = fileStatus(NSString(string: currentDirectoryPath).appendingPathComponent(name)), isDirectory(status) {
+				return currentDirectoryPath
+			}
+
+			let parentDirectoryPath = NSString(string: currentDirectoryPath).deletingLastPathComponent
+			guard parentDirectoryPath != currentDirectoryPath, !parentDirectoryPath.isEmpty else {
+				return nil
+			}
+			currentDirectoryPath = parentDirectoryPath
+		}
+	}
+
+	private static func absolutePath(_ path: String, relativeTo directoryPath: String) -> String {
+		let absolutePath = path.hasPrefix("/") ? path : NSString(string: directoryPath).appendingPathComponent(path)
+		return NSString(string: absolutePath).standardizingPath
+	}
+
+	private static func fileStatus(_ path: String) -> stat? {
+		var status = stat()
+		guard stat(path, &status) == 0 else {
+			return nil
+		}
+		return status
+	}
+
+	private static func isDirectory(_ status: stat) -> Bool {
+		return (status.st_mode & 0o170000) == 0o040000
+	}
+
+	// Files like HEAD are small, so read them entirely and take the first line without its line ending
+	private static func readFirstLine(path: String) -> String? {
+		guard let data = FileManager.default.contents(atPath: path), let contents = String(data: data, encoding: .utf8) else {
+			return nil
+		}
+
+		let firstLine = contents.prefix(while: { !$0.isNewline })
+		return firstLine.trimmingCharacters(in: .whitespaces)
+	}
+}
@@ -0,0 +1,27 @@
+//
+//  Breadcrumbs.swift
+//  Komet
+//
+//  Created by Mayur Pawashe on 10/25/20.
+//  Copyright © 2020 zgcoder. All rights reserved.
+//
+
+import Foundation
+
+public typealias UTF16Offset = Int
+
+public struct Breadcrumbs: Codable {
+	public var textOverflowRanges: Array<Range<UTF16Offset>> = []
+	public var commentLineRanges: Array<Range<UTF16Offset>> = []
+	public var diffHeaderLineRanges: Array<Range<UTF16Offset>> = []
+	public var diffAddLineRanges: Array<Range<UTF16Offset>> = []
+	public var diffRemoveLineRanges: Array<Range<UTF16Offset>> = []
+	public var fileChangeModifiedLineRanges: Array<Range<UTF16Offset>> = []
+	public var fileChangeAddedLineRanges: Array<Range<UTF16Offset>> = []
+	public var fileChangeDeletedLineRanges: Array<Range<UTF16Offset>> = []
+	public var exitStatus: Int32 = 0
+	public var spellChecking: Bool = false
+	
+	public init() {
+	}
+}
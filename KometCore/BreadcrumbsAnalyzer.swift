@@ -0,0 +1,138 @@
+//
+//  BreadcrumbsAnalyzer.swift
+//  Komet
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import Foundation
+
+extension CommitLineKind {
+	// Single character used for each line kind in run-length encodings
+	public var encodingCharacter: Character {
+		switch self {
+		case .content:
+			return "t"
+		case .overflowingContent:
+			return "o"
+		case .comment:
+			return "c"
+		case .commentSectionComment:
+			return "C"
+		case .commentSectionPlain:
+			return "p"
+		case .diffHeader:
+			return "h"
+		case .diffAdd:
+			return "+"
+		case .diffRemove:
+			return "-"
+		case .fileModified:
+			return "M"
+		case .fileAdded:
+			return "A"
+		case .fileDeleted:
+			return "D"
+		}
+	}
+
+	public init?(encodingCharacter: Character) {
+		guard let lineKind = Self.allCases.first(where: { $0.encodingCharacter == encodingCharacter }) else {
+			return nil
+		}
+		self = lineKind
+	}
+
+	// Encodes line kinds as runs of a count followed by the line kind's character, e.g. "2c1t3C11h"
+	public static func runLengthEncoded(_ lineKinds: [CommitLineKind]) -> String {
+		var encoding = ""
+		var runStartIndex = 0
+		while runStartIndex < lineKinds.count {
+			let lineKind = lineKinds[runStartIndex]
+
+			var runEndIndex = runStartIndex + 1
+			while runEndIndex < lineKinds.count && lineKinds[runEndIndex] == lineKind {
+				runEndIndex += 1
+			}
+
+			encoding += "\(runEndIndex - runStartIndex)"
+			encoding.append(lineKind.encodingCharacter)
+
+			runStartIndex = runEndIndex
+		}
+		return encoding
+	}
+
+	// Returns nil if the encoding is malformed
+	public static func runLengthDecoded(_ encoding: String) -> [CommitLineKind]? {
+		var lineKinds: [CommitLineKind] = []
+		var runLength = 0
+		var parsingRunLength = false
+		for character in encoding {
+			if let digit = character.wholeNumberValue, character.isASCII {
+				runLength = runLength * 10 + digit
+				parsingRunLength = true
+			} else {
+				guard parsingRunLength, runLength > 0, let lineKind = CommitLineKind(encodingCharacter: character) else {
+					return nil
+				}
+
+				lineKinds.append(contentsOf: repeatElement(lineKind, count: runLength))
+				runLength = 0
+				parsingRunLength = false
+			}
+		}
+
+		return parsingRunLength ? nil : lineKinds
+	}
+}
+
+public struct BreadcrumbsAnalysis {
+	public let breadcrumbs: Breadcrumbs
+	public let lineKinds: [CommitLineKind]
+}
+
+// Produces the same breadcrumbs the editor records when it styles every line of the commit text,
+// without needing a window or text system
+public struct BreadcrumbsAnalyzer {
+	public typealias Options = CommitLineClassifier.Options
+
+	public static func analyze(text: String, versionControlType: VersionControlType, commentSectionLength: Int, options: Options) -> BreadcrumbsAnalysis {
+		let nsText = NSString(string: text)
+		let lineIndex = CommitLineIndex(text: nsText, versionControlType: versionControlType, commentSectionLength: commentSectionLength)
+
+		let commentSectionIndex = TextProcessor.commentSectionIndex(plainUTF16Text: text.utf16, commentSectionLength: commentSectionLength)
+		let commentSectionHighlights = CommentSectionHighlights(commentSectionText: String(text[commentSectionIndex...]), versionControlType: versionControlType)
+
+		// Classifying is specialized for each built-in comment syntax
+		switch versionControlType {
+		case .git:
+			return analyze(text: nsText, lineIndex: lineIndex, commentSectionHighlights: commentSectionHighlights, commentSyntax: GitCommentSyntax(), options: options)
+		case .hg:
+			return analyze(text: nsText, lineIndex: lineIndex, commentSectionHighlights: commentSectionHighlights, commentSyntax: HGCommentSyntax(), options: options)
+		case .svn:
+			return analyze(text: nsText, lineIndex: lineIndex, commentSectionHighlights: commentSectionHighlights, commentSyntax: SVNCommentSyntax(), options: options)
+		case .jj:
+			return analyze(text: nsText, lineIndex: lineIndex, commentSectionHighlights: commentSectionHighlights, commentSyntax: JJCommentSyntax(), options: options)
+		case .custom(let commentSyntax):
+			return analyze(text: nsText, lineIndex: lineIndex, commentSectionHighlights: commentSectionHighlights, commentSyntax: commentSyntax, options: options)
+		}
+	}
+
+	private static func analyze<Syntax: CommentSyntax>(text: NSString, lineIndex: CommitLineIndex, commentSectionHighlights: CommentSectionHighlights, commentSyntax: Syntax, options: Options) -> BreadcrumbsAnalysis {
+		var breadcrumbs = Breadcrumbs()
+		var lineKinds: [CommitLineKind] = []
+		lineKinds.reserveCapacity(lineIndex.lineCount)
+
+		for lineNumber in 0 ..< lineIndex.lineCount {
+			let range = lineIndex.lineRange(at: lineNumber, in: text)
+			let classification = CommitLineClassifier.classify(text.substring(with: range), location: range.location, lineIndex: lineIndex, commentSectionHighlights: commentSectionHighlights, commentSyntax: commentSyntax, options: options)
+
+			classification.record(in: &breadcrumbs, location: range.location)
+			lineKinds.append(classification.kind)
+		}
+
+		return BreadcrumbsAnalysis(breadcrumbs: breadcrumbs, lineKinds: lineKinds)
+	}
+}
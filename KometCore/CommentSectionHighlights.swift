@@ -0,0 +1,172 @@
+//
+//  CommentSectionHighlights.swift
+//  Komet
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import Foundation
+
+public enum CommentSectionLineKind: UInt8 {
+	case comment
+	// A non-comment line that is not highlighted (e.g. diff context lines)
+	case plain
+	case diffHeader
+	case diffAdd
+	case diffRemove
+	// Comment lines that label a changed file
+	case fileModified
+	case fileAdded
+	case fileDeleted
+
+	public var isComment: Bool {
+		switch self {
+		case .comment, .fileModified, .fileAdded, .fileDeleted:
+			return true
+		case .plain, .diffHeader, .diffAdd, .diffRemove:
+			return false
+		}
+	}
+
+	public var fileChangeType: FileChangeType? {
+		switch self {
+		case .fileModified:
+			return .modified
+		case .fileAdded:
+			return .added
+		case .fileDeleted:
+			return .deleted
+		case .comment, .plain, .diffHeader, .diffAdd, .diffRemove:
+			return nil
+		}
+	}
+}
+
+// The comment section (including scissored content) can't be edited, so we only need to classify its lines once.
+// This is built on a background queue when the content is loaded; styling a paragraph then only needs to look up its line kind,
+// and changing the theme or font only needs to map line kinds to different attributes.
+public struct CommentSectionHighlights {
+	private let lineKinds: [CommentSectionLineKind]
+
+	public init(commentSectionText: String, versionControlType: VersionControlType) {
+		let text = NSString(string: commentSectionText)
+
+		// Classifying is specialized for each built-in comment syntax
+		switch versionControlType {
+		case .git:
+			lineKinds = Self.lineKinds(text, commentSyntax: GitCommentSyntax())
+		case .hg:
+			lineKinds = Self.lineKinds(text, commentSyntax: HGCommentSyntax())
+		case .svn:
+			lineKinds = Self.lineKinds(text, commentSyntax: SVNCommentSyntax())
+		case .jj:
+			lineKinds = Self.lineKinds(text, commentSyntax: JJCommentSyntax())
+		case .custom(let commentSyntax):
+			lineKinds = Self.lineKinds(text, commentSyntax: commentSyntax)
+		}
+	}
+
+	public var lineCount: Int {
+		return lineKinds.count
+	}
+
+	// The line index is relative to the start of the comment section
+	public func lineKind(at lineIndex: Int) -> CommentSectionLineKind? {
+		return lineIndex < lineKinds.count ? lineKinds[lineIndex] : nil
+	}
+
+	// Generic over the comment syntax so the syntax is resolved once for all of the lines instead of for each one
+	private static func lineKinds<Syntax: CommentSyntax>(_ text: NSString, commentSyntax: Syntax) -> [CommentSectionLineKind] {
+		let textLength = text.length
+
+		var lineKinds: [CommentSectionLineKind] = []
+		var lineStart = 0
+		while lineStart < textLength {
+			var lineStartIndex = 0
+			var lineEndIndex = 0
+			var contentEndIndex = 0
+
+			text.getLineStart(&lineStartIndex, end: &lineEndIndex, contentsEnd: &contentEndIndex, for: NSMakeRange(lineStart, 0))
+
+			let line = text.substring(with: NSMakeRange(lineStartIndex, contentEndIndex - lineStartIndex))
+			lineKinds.append(lineKind(line, commentSyntax: commentSyntax))
+
+			lineStart = lineEndIndex
+		}
+
+		return lineKinds
+	}
+
+	// Classifies a single line from the comment section
+	// Callers classifying lines one at a time should hold on to the comment syntax rather than looking it up for every line
+	public static func lineKind<Syntax: CommentSyntax>(_ line: String, commentSyntax: Syntax) -> CommentSectionLineKind {
+		// For svn, every line in the comment section is formatted as a comment
+		// For git, scissored content may be in the comment section but we don't want to format those lines as comments
+		let isCommentParagraph = commentSyntax.hasSingleCommentLineMarker || commentSyntax.isCommentLine(line)
+
+		if isCommentParagraph {
+			if #available(macOS 13, *), let (label, _) = commentSyntax.labelInCommentLine(line) {
+				switch commentSyntax.fileChangeType(label: label) {
+				case .modified:
+					return .fileModified
+				case .added:
+					return .fileAdded
+				case .deleted:
+					return .fileDeleted
+				case nil:
+					break
+				}
+			}
+			return .comment
+		}
+
+		guard commentSyntax.highlightsScissoredDiffs else {
+			return .plain
+		}
+
+		return diffLineKind(line)
+	}
+
+	// Dispatch on the first byte so only a few prefixes need to be compared for each line
+	// https://git-scm.com/docs/git-diff-index documents the possible header line prefixes
+	private static func diffLineKind(_ line: String) -> CommentSectionLineKind {
+		guard let firstByte = line.utf8.first else {
+			return .plain
+		}
+
+		let isHeader: Bool
+		switch firstByte {
+		case UInt8(ascii: "@"):
+			isHeader = line.hasPrefix("@@")
+		case UInt8(ascii: "+"):
+			if line.hasPrefix("+++") {
+				return .diffHeader
+			}
+			return line.hasPrefix("+") ? .diffAdd : .plain
+		case UInt8(ascii: "-"):
+			if line.hasPrefix("---") {
+				return .diffHeader
+			}
+			return line.hasPrefix("-") ? .diffRemove : .plain
+		case UInt8(ascii: "d"):
+			isHeader = line.hasPrefix("diff ") || line.hasPrefix("deleted file mode") || line.hasPrefix("dissimilarity index")
+		case UInt8(ascii: "i"):
+			isHeader = line.hasPrefix("index ") && line.contains("..")
+		case UInt8(ascii: "n"):
+			isHeader = line.hasPrefix("new file mode") || line.hasPrefix("new mode")
+		case UInt8(ascii: "c"):
+			isHeader = line.hasPrefix("copy from") || line.hasPrefix("copy to")
+		case UInt8(ascii: "r"):
+			isHeader = line.hasPrefix("rename from") || line.hasPrefix("rename to")
+		case UInt8(ascii: "s"):
+			isHeader = line.hasPrefix("similarity index")
+		case UInt8(ascii: "o"):
+			isHeader = line.hasPrefix("old mode")
+		default:
+			isHeader = false
+		}
+
+		return isHeader ? .diffHeader : .plain
+	}
+}
@@ -0,0 +1,256 @@
+//
+//  CommentSyntax.swift
+//  Komet
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import Foundation
+#if canImport(Darwin)
+import Darwin
+#elseif canImport(Glibc)
+import Glibc
+#endif
+
+// How the label of a file change comment line (e.g. "modified:" in "#	modified:   File.swift") ends
+public enum CommentLabelSeparator: String, Decodable {
+	case colon
+	case whitespace
+}
+
+// How the line that ends the editable part of the comment section is recognized
+public enum ScissorRule: Equatable {
+	case none
+	// git's "# ------------------------ >8 ------------------------", using the syntax's comment prefix
+	case scissors
+	// A line that must match exactly, like jj's "JJ: ignore-rest"
+	case exactLine(String)
+}
+
+// Describes how a version control system formats the comments in its commit message templates.
+// Code that classifies many lines is generic over the syntax, so a descriptor is looked up once per text
+// rather than switching over the version control type for every line.
+public protocol CommentSyntax {
+	var prefix: String { get }
+	var suffix: String { get }
+	// For svn, every line past the first comment line is part of the comment section
+	var hasSingleCommentLineMarker: Bool { get }
+	var scissorRule: ScissorRule { get }
+	// nil if comment lines don't label changed files
+	var labelSeparator: CommentLabelSeparator? { get }
+	var fileChangeLabels: [String: FileChangeType] { get }
+	// Content below the scissor line may include a diff that we want to highlight
+	var highlightsScissoredDiffs: Bool { get }
+}
+
+extension CommentSyntax {
+	public func commentLine(_ text: String) -> String {
+		return suffix.isEmpty ? "\(prefix) \(text)" : "\(prefix) \(text) \(suffix)"
+	}
+
+	public func isCommentLine(_ line: String) -> Bool {
+		// Note a line that is "--" could have the prefix and suffix the same, but we want to make sure it's at least "--...--" length long
+		return line.hasPrefix(prefix) && line.hasSuffix(suffix) && line.count >= prefix.count + suffix.count
+	}
+
+	public func isScissorLine(_ line: String) -> Bool {
+		switch scissorRule {
+		case .none:
+			return false
+		case .scissors:
+			return line.hasPrefix(prefix + " --") && line.hasSuffix("--") && line.contains(">8")
+		case .exactLine(let marker):
+			return line == marker
+		}
+	}
+
+	// Returns the label and the length of the comment prefix in characters
+	@available(macOS 13, *)
+	public func labelInCommentLine(_ line: String) -> (String, Int)? {
+		guard let labelSeparator, line.hasPrefix(prefix) else {
+			return nil
+		}
+
+		let commentPrefixLength = prefix.count
+		let remainingLine = line[line.index(line.startIndex, offsetBy: commentPrefixLength) ..< line.endIndex]
+		let trimmedRemainingLine = remainingLine.trimmingPrefix { character in
+			character == " " || character == "\t"
+		}
+
+		let separatorIndex: Substring.Index?
+		switch labelSeparator {
+		case .colon:
+			separatorIndex = trimmedRemainingLine.firstIndex(of: ":")
+		case .whitespace:
+			separatorIndex = trimmedRemainingLine.firstIndex(where: { character in
+				character == " " || character == "\t"
+			})
+		}
+
+		guard let separatorIndex else {
+			return nil
+		}
+
+		let label = trimmedRemainingLine[..<separatorIndex]
+		return (String(label), commentPrefixLength)
+	}
+
+	public func fileChangeType(label: String) -> FileChangeType? {
+		return fileChangeLabels[label]
+	}
+}
+
+public struct GitCommentSyntax: CommentSyntax {
+	public let prefix = "#"
+	public let suffix = ""
+	public let hasSingleCommentLineMarker = false
+	public let scissorRule = ScissorRule.scissors
+	public let labelSeparator: CommentLabelSeparator? = .colon
+	public let fileChangeLabels: [String: FileChangeType] = [
+		"renamed": .modified,
+		"copied": .modified,
+		"modified": .modified,
+		"new file": .added,
+		"deleted": .deleted
+	]
+	public let highlightsScissoredDiffs = true
+
+	public init() {
+	}
+}
+
+public struct HGCommentSyntax: CommentSyntax {
+	public let prefix = "HG:"
+	public let suffix = ""
+	public let hasSingleCommentLineMarker = false
+	public let scissorRule = ScissorRule.none
+	public let labelSeparator: CommentLabelSeparator? = .whitespace
+	public let fileChangeLabels: [String: FileChangeType] = [
+		"changed": .modified,
+		"added": .added,
+		"removed": .deleted
+	]
+	public let highlightsScissoredDiffs = false
+
+	public init() {
+	}
+}
+
+public struct SVNCommentSyntax: CommentSyntax {
+	public let prefix = "--"
+	public let suffix = "--"
+	public let hasSingleCommentLineMarker = true
+	public let scissorRule = ScissorRule.none
+	// Not testing svn for file changes
+	public let labelSeparator: CommentLabelSeparator? = nil
+	public let fileChangeLabels: [String: FileChangeType] = [:]
+	public let highlightsScissoredDiffs = false
+
+	public init() {
+	}
+}
+
+public struct JJCommentSyntax: CommentSyntax {
+	public let prefix = "JJ:"
+	public let suffix = ""
+	public let hasSingleCommentLineMarker = false
+	public let scissorRule = ScissorRule.exactLine("JJ: ignore-rest")
+	public let labelSeparator: CommentLabelSeparator? = .whitespace
+	public let fileChangeLabels: [String: FileChangeType] = [
+		"R": .modified,
+		"C": .modified,
+		"M": .modified,
+		"A": .added,
+		"D": .deleted
+	]
+	public let highlightsScissoredDiffs = true
+
+	public init() {
+	}
+}
+
+// A comment syntax read from the user's comment syntaxes file, for version control systems Komet doesn't know about
+// or for a git repository with a custom core.commentChar
+public struct CustomCommentSyntax: CommentSyntax, Equatable, Decodable {
+	public let name: String
+	// Commit files whose path matches one of these shell wildcard patterns (see fnmatch(3)) use this syntax
+	public let filePatterns: [String]
+	// The version control system that provides the commit file, if Komet knows about it
+	public let baseVersionControlType: VersionControlType?
+	public let prefix: String
+	public let suffix: String
+	public let hasSingleCommentLineMarker: Bool
+	public let scissorRule: ScissorRule
+	public let labelSeparator: CommentLabelSeparator?
+	public let fileChangeLabels: [String: FileChangeType]
+	public let highlightsScissoredDiffs: Bool
+
+	private enum CodingKeys: String, CodingKey {
+		case name
+		case filePatterns
+		case versionControl
+		case commentPrefix
+		case commentSuffix
+		case singleCommentLineMarker
+		case scissors
+		case scissorLine
+		case labelSeparator
+		case fileChangeLabels
+		case highlightsScissoredDiffs
+	}
+
+	public init(from decoder: Decoder) throws {
+		let container = try decoder.container(keyedBy: CodingKeys.self)
+
+		name = try container.decode(String.self, forKey: .name)
+		filePatterns = try container.decode([String].self, forKey: .filePatterns)
+		prefix = try container.decode(String.self, forKey: .commentPrefix)
+		suffix = try container.decodeIfPresent(String.self, forKey: .commentSuffix) ?? ""
+		hasSingleCommentLineMarker = try container.decodeIfPresent(Bool.self, forKey: .singleCommentLineMarker) ?? false
+		labelSeparator = try container.decodeIfPresent(CommentLabelSeparator.self, forKey: .labelSeparator)
+		fileChangeLabels = try container.decodeIfPresent([String: FileChangeType].self, forKey: .fileChangeLabels) ?? [:]
+		highlightsScissoredDiffs = try container.decodeIfPresent(Bool.self, forKey: .highlightsScissoredDiffs) ?? false
+
+		guard !prefix.isEmpty else {
+			throw DecodingError.dataCorruptedError(forKey: .commentPrefix, in: container, debugDescription: "Comment prefix must not be empty")
+		}
+
+		if let scissorLine = try container.decodeIfPresent(String.self, forKey: .scissorLine) {
+			scissorRule = .exactLine(scissorLine)
+		} else if try container.decodeIfPresent(Bool.self, forKey: .scissors) ?? false {
+			scissorRule = .scissors
+		} else {
+			scissorRule = .none
+		}
+
+		switch try container.decodeIfPresent(String.self, forKey: .versionControl) {
+		case nil:
+			baseVersionControlType = nil
+		case "git"?:
+			baseVersionControlType = .git
+		case "hg"?:
+			baseVersionControlType = .hg
+		case "svn"?:
+			baseVersionControlType = .svn
+		case "jj"?:
+			baseVersionControlType = .jj
+		case let versionControl?:
+			throw DecodingError.dataCorruptedError(forKey: .versionControl, in: container, debugDescription: "Unknown version control system \(versionControl)")
+		}
+	}
+
+	// Reads the comment syntaxes file, which is a JSON array of syntaxes
+	public static func load(contentsOf fileURL: URL) throws -> [CustomCommentSyntax] {
+		let data = try Data(contentsOf: fileURL)
+		return try JSONDecoder().decode([CustomCommentSyntax].self, from: data)
+	}
+
+	// The first syntax with a file pattern matching the commit file wins
+	public static func matching(fileURL: URL, in syntaxes: [CustomCommentSyntax]) -> CustomCommentSyntax? {
+		let filePath = fileURL.standardizedFileURL.path
+		return syntaxes.first(where: { syntax in
+			syntax.filePatterns.contains(where: { fnmatch($0, filePath, 0) == 0 })
+		})
+	}
+}
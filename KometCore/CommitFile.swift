@@ -0,0 +1,147 @@
+//
+//  CommitFile.swift
+//  Komet
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import Foundation
+
+// Scissored content that was too large to load into the editor.
+// The placeholder is shown at the end of the comment section in its place.
+public struct CollapsedScissoredContent {
+	public let placeholder: String
+	public let data: Data
+
+	// Describes how much content was collapsed, e.g. "2.3 MB of content below was not loaded. Click to expand it."
+	// The app's localized format is used when it's available.
+	public static func placeholderDescription(collapsedByteCount: Int) -> String {
+		let byteCountDescription = ByteCountFormatter.string(fromByteCount: Int64(collapsedByteCount), countStyle: .file)
+		let format = NSLocalizedString("collapsedScissoredContentFormat", tableName: nil, bundle: .main, value: "%@ of content below was not loaded. Click to expand it.", comment: "")
+		// String(format:) can't be passed a Swift String on every platform
+		return format.replacingOccurrences(of: "%@", with: byteCountDescription)
+	}
+}
+
+// A memory mapped commit file that can answer questions about its contents without copying them,
+// and only materializes the text that will be loaded into the editor.
+public struct CommitFile {
+	private let data: Data
+
+	public init(contentsOf fileURL: URL) throws {
+		data = try Data(contentsOf: fileURL, options: .mappedIfSafe)
+	}
+
+	// Equivalent to checking that components(separatedBy: .newlines) yields more than one line
+	public var containsLineBreak: Bool {
+		return data.contains(where: { (0x0A ... 0x0D).contains($0) }) ||
+			data.range(of: Data([0xC2, 0x85])) != nil ||
+			data.range(of: Data([0xE2, 0x80, 0xA8])) != nil ||
+			data.range(of: Data([0xE2, 0x80, 0xA9])) != nil
+	}
+
+	public func contains(_ string: String) -> Bool {
+		return data.range(of: Data(string.utf8)) != nil
+	}
+
+	// Loads the commit text. If the content below the scissor line is larger than collapseThreshold,
+	// only a preview of it is loaded and the remainder is collapsed behind a placeholder comment line.
+	// Returns nil if the loaded text is not valid UTF-8.
+	public func loadText(versionControlType: VersionControlType, collapseThreshold: Int, previewLength: Int, placeholder: (Int) -> String) -> (String, CollapsedScissoredContent?)? {
+		let byteCount = data.count
+
+		var collapsedOffset: Int? = nil
+		if collapseThreshold > 0 && byteCount > collapseThreshold {
+			let scissoredContentOffset = data.withUnsafeBytes { rawBytes in
+				return TextProcessor.scanLines(bytes: rawBytes.bindMemory(to: UInt8.self), versionControlType: versionControlType, findingCommentSection: true).scissoredContentOffset
+			}
+
+			if let scissoredContentOffset, byteCount - scissoredContentOffset > collapseThreshold {
+				// Collapse at a line boundary so the placeholder gets its own line
+				let previewEndOffset = min(scissoredContentOffset + previewLength, byteCount)
+				collapsedOffset = data[(data.startIndex + previewEndOffset)...].firstIndex(of: 0x0A).map({ $0 - data.startIndex + 1 })
+			}
+		}
+
+		// Content that isn't valid UTF-8 is never collapsed, so it's rejected the same way as the rest of the file
+		guard let collapsedOffset, collapsedOffset < byteCount, Self.isValidUTF8(data[(data.startIndex + collapsedOffset)...]) else {
+			return String(data: data, encoding: .utf8).map({ ($0, nil) })
+		}
+
+		guard let loadedText = String(data: data[data.startIndex ..< data.startIndex + collapsedOffset], encoding: .utf8) else {
+			return nil
+		}
+
+		let collapsedData = data[(data.startIndex + collapsedOffset)...]
+		let placeholderText = placeholder(collapsedData.count)
+
+		return (loadedText.appending(placeholderText), CollapsedScissoredContent(placeholder: placeholderText, data: collapsedData))
+	}
+
+	// Accepts the same bytes as String(data:encoding: .utf8), rejecting overlong encodings, surrogates and code points past U+10FFFF.
+	// This is much cheaper than decoding the collapsed content, which we may never need to do.
+	private static func isValidUTF8(_ data: Data) -> Bool {
+		return data.withUnsafeBytes { rawBytes in
+			let bytes = rawBytes.bindMemory(to: UInt8.self)
+			let count = bytes.count
+
+			var index = 0
+			while index < count {
+				// Skip over ASCII a chunk at a time
+				if index + 16 <= count {
+					let chunk = UnsafeRawPointer(bytes.baseAddress! + index).loadUnaligned(as: SIMD16<UInt8>.self)
+					if !any(chunk .>= SIMD16<UInt8>(repeating: 0x80)) {
+						index += 16
+						continue
+					}
+				}
+
+				let leadByte = bytes[index]
+				if leadByte < 0x80 {
+					index += 1
+					continue
+				}
+
+				let sequenceLength: Int
+				var secondByteRange: ClosedRange<UInt8> = 0x80 ... 0xBF
+				switch leadByte {
+				case 0xC2 ... 0xDF:
+					sequenceLength = 2
+				case 0xE0:
+					sequenceLength = 3
+					secondByteRange = 0xA0 ... 0xBF
+				case 0xE1 ... 0xEC, 0xEE ... 0xEF:
+					sequenceLength = 3
+				case 0xED:
+					sequenceLength = 3
+					secondByteRange = 0x80 ... 0x9F
+				case 0xF0:
+					sequenceLength = 4
+					secondByteRange = 0x90 ... 0xBF
+				case 0xF1 ... 0xF3:
+					sequenceLength = 4
+				case 0xF4:
+					sequenceLength = 4
+					secondByteRange = 0x80 ... 0x8F
+				default:
+					return false
+				}
+
+				guard index + sequenceLength <= count, secondByteRange.contains(bytes[index + 1]) else {
+					return false
+				}
+
+				for continuationIndex in index + 2 ..< index + sequenceLength {
+					guard bytes[continuationIndex] & 0xC0 == 0x80 else {
+						return false
+					}
+				}
+
+				index += sequenceLength
+			}
+
+			return true
+		}
+	}
+}
@@ -0,0 +1,193 @@
+//
+//  CommitLineClassifier.swift
+//  Komet
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import Foundation
+
+// How a line of commit text is highlighted by the editor
+public enum CommitLineKind: UInt8, CaseIterable {
+	// Content lines before the comment section
+	case content
+	case overflowingContent
+	case comment
+	// Lines in the comment section
+	case commentSectionComment
+	case commentSectionPlain
+	case diffHeader
+	case diffAdd
+	case diffRemove
+	case fileModified
+	case fileAdded
+	case fileDeleted
+
+	// Comment lines are styled with the comment font, while other lines are styled with the content font
+	public var isComment: Bool {
+		switch self {
+		case .comment, .commentSectionComment, .fileModified, .fileAdded, .fileDeleted:
+			return true
+		case .content, .overflowingContent, .commentSectionPlain, .diffHeader, .diffAdd, .diffRemove:
+			return false
+		}
+	}
+}
+
+// A classified line and the ranges within it that are highlighted.
+// Ranges are in UTF-16 offsets relative to the start of the line.
+public struct CommitLineClassification {
+	public let kind: CommitLineKind
+	public let length: Int
+	// Only for overflowing content lines
+	public let overflowRange: NSRange?
+	// Only for file change lines; the comment prefix before it is styled as a comment
+	public let fileChangeRange: NSRange?
+
+	// Only for diff lines in the comment section
+	public var diffRange: NSRange? {
+		switch kind {
+		case .diffHeader, .diffAdd, .diffRemove:
+			return NSMakeRange(0, length)
+		case .content, .overflowingContent, .comment, .commentSectionComment, .commentSectionPlain, .fileModified, .fileAdded, .fileDeleted:
+			return nil
+		}
+	}
+
+	// Only for comment lines outside of the comment section
+	public var commentRange: NSRange? {
+		return (kind == .comment) ? NSMakeRange(0, length) : nil
+	}
+
+	// Records the breadcrumbs the editor reports for this line, which starts at location in the text.
+	// Diff and file change ranges are relative to the start of the line, while overflow and comment ranges are not.
+	public func record(in breadcrumbs: inout Breadcrumbs, location: UTF16Offset) {
+		if let overflowRange {
+			breadcrumbs.textOverflowRanges.append(location + overflowRange.location ..< location + NSMaxRange(overflowRange))
+		}
+
+		if let commentRange {
+			breadcrumbs.commentLineRanges.append(location + commentRange.location ..< location + NSMaxRange(commentRange))
+		}
+
+		if let diffRange {
+			let lineRange = diffRange.location ..< NSMaxRange(diffRange)
+			switch kind {
+			case .diffHeader:
+				breadcrumbs.diffHeaderLineRanges.append(lineRange)
+			case .diffAdd:
+				breadcrumbs.diffAddLineRanges.append(lineRange)
+			case .diffRemove:
+				breadcrumbs.diffRemoveLineRanges.append(lineRange)
+			case .content, .overflowingContent, .comment, .commentSectionComment, .commentSectionPlain, .fileModified, .fileAdded, .fileDeleted:
+				break
+			}
+		}
+
+		if let fileChangeRange {
+			let fileChangedRange = fileChangeRange.location ..< NSMaxRange(fileChangeRange)
+			switch kind {
+			case .fileModified:
+				breadcrumbs.fileChangeModifiedLineRanges.append(fileChangedRange)
+			case .fileAdded:
+				breadcrumbs.fileChangeAddedLineRanges.append(fileChangedRange)
+			case .fileDeleted:
+				breadcrumbs.fileChangeDeletedLineRanges.append(fileChangedRange)
+			case .content, .overflowingContent, .comment, .commentSectionComment, .commentSectionPlain, .diffHeader, .diffAdd, .diffRemove:
+				break
+			}
+		}
+	}
+}
+
+// Decides how each line of commit text is highlighted.
+// The editor styles its paragraphs with this and BreadcrumbsAnalyzer produces breadcrumbs with it, so both always agree.
+public struct CommitLineClassifier {
+	public struct Options {
+		public var versionControlledFile: Bool
+		public var isSquashMessage: Bool
+		// nil if the limit warning is disabled
+		public var subjectLengthLimit: Int?
+		public var bodyLineLengthLimit: Int?
+		public var highlightsFileChanges: Bool
+
+		// Defaults match the editor's registered defaults
+		public init(versionControlledFile: Bool = true, isSquashMessage: Bool = false, subjectLengthLimit: Int? = 69, bodyLineLengthLimit: Int? = nil, highlightsFileChanges: Bool = true) {
+			self.versionControlledFile = versionControlledFile
+			self.isSquashMessage = isSquashMessage
+			self.subjectLengthLimit = subjectLengthLimit
+			self.bodyLineLengthLimit = bodyLineLengthLimit
+			self.highlightsFileChanges = highlightsFileChanges
+		}
+	}
+
+	// Classifies the line starting at location in the text lineIndex was built for.
+	// Lines in the comment section are looked up in commentSectionHighlights if they have been classified ahead of time.
+	public static func classify<Syntax: CommentSyntax>(_ line: String, location: UTF16Offset, lineIndex: CommitLineIndex, commentSectionHighlights: CommentSectionHighlights?, commentSyntax: Syntax, options: Options) -> CommitLineClassification {
+		let length = line.utf16.count
+		let isCommentSection = (location >= lineIndex.commentSectionLocation)
+
+		let commentSectionLineKind: CommentSectionLineKind?
+		if isCommentSection {
+			commentSectionLineKind = precomputedCommentSectionLineKind(at: location, lineIndex: lineIndex, commentSectionHighlights: commentSectionHighlights) ?? CommentSectionHighlights.lineKind(line, commentSyntax: commentSyntax)
+		} else {
+			commentSectionLineKind = nil
+		}
+
+		let isCommentLine = commentSectionLineKind?.isComment ?? commentSyntax.isCommentLine(line)
+
+		if !isCommentLine {
+			if options.versionControlledFile {
+				if commentSyntax.highlightsScissoredDiffs && isCommentSection {
+					switch commentSectionLineKind ?? .plain {
+					case .diffHeader:
+						return CommitLineClassification(kind: .diffHeader, length: length, overflowRange: nil, fileChangeRange: nil)
+					case .diffAdd:
+						return CommitLineClassification(kind: .diffAdd, length: length, overflowRange: nil, fileChangeRange: nil)
+					case .diffRemove:
+						return CommitLineClassification(kind: .diffRemove, length: length, overflowRange: nil, fileChangeRange: nil)
+					case .comment, .plain, .fileModified, .fileAdded, .fileDeleted:
+						break
+					}
+				} else if !options.isSquashMessage, let firstContentLineLocation = lineIndex.firstContentLineLocation {
+					let lengthLimit = (location == firstContentLineLocation) ? options.subjectLengthLimit : options.bodyLineLengthLimit
+					if let lengthLimit, let overflowRange = LineMeasurement.overflowUTF16Range(line: line, lengthLimit: lengthLimit) {
+						return CommitLineClassification(kind: .overflowingContent, length: length, overflowRange: overflowRange, fileChangeRange: nil)
+					}
+				}
+			}
+
+			return CommitLineClassification(kind: isCommentSection ? .commentSectionPlain : .content, length: length, overflowRange: nil, fileChangeRange: nil)
+		}
+
+		guard isCommentSection else {
+			return CommitLineClassification(kind: .comment, length: length, overflowRange: nil, fileChangeRange: nil)
+		}
+
+		let commentPrefixLength = commentSyntax.prefix.utf16.count
+		if options.versionControlledFile && options.highlightsFileChanges, let fileChangeType = commentSectionLineKind?.fileChangeType, length > commentPrefixLength {
+			let fileChangeRange = NSMakeRange(commentPrefixLength, length - commentPrefixLength)
+			let kind: CommitLineKind
+			switch fileChangeType {
+			case .modified:
+				kind = .fileModified
+			case .added:
+				kind = .fileAdded
+			case .deleted:
+				kind = .fileDeleted
+			}
+			return CommitLineClassification(kind: kind, length: length, overflowRange: nil, fileChangeRange: fileChangeRange)
+		}
+
+		return CommitLineClassification(kind: .commentSectionComment, length: length, overflowRange: nil, fileChangeRange: nil)
+	}
+
+	private static func precomputedCommentSectionLineKind(at location: UTF16Offset, lineIndex: CommitLineIndex, commentSectionHighlights: CommentSectionHighlights?) -> CommentSectionLineKind? {
+		guard let commentSectionHighlights, let lineNumber = lineIndex.lineIndex(containing: location), lineIndex.lineStart(at: lineNumber) == location else {
+			return nil
+		}
+
+		return commentSectionHighlights.lineKind(at: lineNumber - lineIndex.contentLineCount)
+	}
+}
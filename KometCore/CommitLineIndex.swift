@@ -0,0 +1,262 @@
+//
+//  CommitLineIndex.swift
+//  Komet
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import Foundation
+
+// Tracks the UTF-16 line offsets of the commit text along with the comment section boundary
+// and the location of the first content line, so we don't need to re-scan the text every time a paragraph is styled.
+// The comment section is never editable, so its line offsets are stored relative to the start of the comment section
+// and never need to be adjusted when the user edits content above it.
+public struct CommitLineIndex {
+	private let versionControlType: VersionControlType
+	private let commentSectionLength: Int
+
+	public private(set) var length: Int = 0
+
+	// Absolute line start offsets for lines before the comment section
+	private var contentLineStarts: [UTF16Offset] = []
+	// Line start offsets relative to the beginning of the comment section
+	private var commentLineStarts: [UTF16Offset] = []
+
+	// Index into contentLineStarts for the first non-comment line, if there is one
+	private var firstContentLineIndex: Int? = nil
+	// Offset relative to the comment section for the first non-comment line in the comment section, if there is one
+	private var commentSectionFirstContentLineOffset: UTF16Offset? = nil
+
+	public init(versionControlType: VersionControlType, commentSectionLength: Int) {
+		self.versionControlType = versionControlType
+		self.commentSectionLength = commentSectionLength
+	}
+
+	public init(text: NSString, versionControlType: VersionControlType, commentSectionLength: Int) {
+		self.init(versionControlType: versionControlType, commentSectionLength: commentSectionLength)
+		rebuild(text: text)
+	}
+
+	// MARK: Queries
+
+	public var commentSectionLocation: UTF16Offset {
+		return length - commentSectionLength
+	}
+
+	public var lineCount: Int {
+		return contentLineStarts.count + commentLineStarts.count
+	}
+
+	// Number of lines before the comment section
+	public var contentLineCount: Int {
+		return contentLineStarts.count
+	}
+
+	// The location of the first line that is not a comment line, which may be found in the comment section (e.g. scissored diffs)
+	public var firstContentLineLocation: UTF16Offset? {
+		if let firstContentLineIndex {
+			return contentLineStarts[firstContentLineIndex]
+		} else if let commentSectionFirstContentLineOffset {
+			return commentSectionLocation + commentSectionFirstContentLineOffset
+		} else {
+			return nil
+		}
+	}
+
+	public func lineStart(at lineIndex: Int) -> UTF16Offset {
+		let contentLineCount = contentLineStarts.count
+		if lineIndex < contentLineCount {
+			return contentLineStarts[lineIndex]
+		} else {
+			return commentSectionLocation + commentLineStarts[lineIndex - contentLineCount]
+		}
+	}
+
+	// Returns the index of the line containing the location, or nil if there are no lines
+	public func lineIndex(containing location: UTF16Offset) -> Int? {
+		let commentSectionLocation = self.commentSectionLocation
+		if location >= commentSectionLocation && !commentLineStarts.isEmpty {
+			return contentLineStarts.count + Self.lastIndex(in: commentLineStarts, notGreaterThan: location - commentSectionLocation)
+		} else if !contentLineStarts.isEmpty {
+			return Self.lastIndex(in: contentLineStarts, notGreaterThan: location)
+		} else {
+			return nil
+		}
+	}
+
+	// Range of the line's contents, excluding its line separator
+	public func lineRange(at lineIndex: Int, in text: NSString) -> NSRange {
+		let start = lineStart(at: lineIndex)
+		let end = (lineIndex + 1 < lineCount) ? lineStart(at: lineIndex + 1) : length
+
+		var contentsEnd = end
+		if contentsEnd > start {
+			let lastCharacter = text.character(at: contentsEnd - 1)
+			if Self.isLineSeparator(lastCharacter) {
+				contentsEnd -= 1
+				if lastCharacter == 0x0A && contentsEnd > start && text.character(at: contentsEnd - 1) == 0x0D {
+					contentsEnd -= 1
+				}
+			}
+		}
+
+		return NSMakeRange(start, contentsEnd - start)
+	}
+
+	public func lineRange(containing location: UTF16Offset, in text: NSString) -> NSRange? {
+		guard let lineIndex = lineIndex(containing: location) else {
+			return nil
+		}
+		return lineRange(at: lineIndex, in: text)
+	}
+
+	// MARK: Updates
+
+	// Should be called after the text has been edited, with the edited range and change in length reported by NSTextStorage
+	public mutating func textDidChange(_ text: NSString, editedRange: NSRange, changeInLength delta: Int) {
+		let newLength = text.length
+		let oldLength = newLength - delta
+		let oldEditedEnd = NSMaxRange(editedRange) - delta
+		let oldCommentSectionLocation = oldLength - commentSectionLength
+
+		// Edits are only allowed before the comment section; anything else (like the initial load) requires re-building everything
+		guard oldLength == length, oldCommentSectionLocation >= 0, commentSectionLength == 0 || oldEditedEnd < oldCommentSectionLocation else {
+			rebuild(text: text)
+			return
+		}
+
+		// The line containing the character before the edit is the first line that could be affected,
+		// (e.g. a newline may be removed, or a \n may be inserted after a \r)
+		let anchorLineIndex = contentLineStarts.isEmpty ? 0 : Self.lastIndex(in: contentLineStarts, notGreaterThan: max(editedRange.location - 1, 0))
+		let scanStart = contentLineStarts.isEmpty ? 0 : contentLineStarts[anchorLineIndex]
+
+		let newEditedEnd = NSMaxRange(editedRange)
+		let newCommentSectionLocation = newLength - commentSectionLength
+
+		// Re-scan lines until we find a line that starts past the edited range;
+		// everything from that line onwards is unchanged aside from being shifted by delta
+		var scannedLineStarts: [UTF16Offset] = []
+		var resumeLocation = newCommentSectionLocation
+		var lineStart = scanStart
+		while lineStart < newCommentSectionLocation {
+			if lineStart > newEditedEnd {
+				resumeLocation = lineStart
+				break
+			}
+
+			scannedLineStarts.append(lineStart)
+			lineStart = Self.lineEnd(in: text, at: lineStart)
+		}
+
+		let oldResumeLocation = resumeLocation - delta
+		let replacedEndIndex = Self.firstIndex(in: contentLineStarts, notLessThan: oldResumeLocation)
+
+		for shiftedIndex in replacedEndIndex ..< contentLineStarts.count {
+			contentLineStarts[shiftedIndex] += delta
+		}
+		contentLineStarts.replaceSubrange(anchorLineIndex ..< replacedEndIndex, with: scannedLineStarts)
+
+		length = newLength
+
+		// Lines before the anchor line are unchanged, so only re-compute the first content line if it could have been affected
+		if let firstContentLineIndex, firstContentLineIndex < anchorLineIndex {
+			return
+		}
+		updateFirstContentLineIndex(text: text, startingAt: anchorLineIndex)
+	}
+
+	public mutating func rebuild(text: NSString) {
+		length = text.length
+
+		let commentSectionLocation = self.commentSectionLocation
+
+		contentLineStarts = []
+		commentLineStarts = []
+		commentSectionFirstContentLineOffset = nil
+
+		var lineStart = 0
+		while lineStart < length {
+			if lineStart < commentSectionLocation {
+				contentLineStarts.append(lineStart)
+			} else {
+				commentLineStarts.append(lineStart - commentSectionLocation)
+			}
+
+			lineStart = Self.lineEnd(in: text, at: lineStart)
+		}
+
+		// The comment section can't change, so we only need to find its first content line once
+		let contentLineCount = contentLineStarts.count
+		commentSectionFirstContentLineOffset = findFirstContentLineIndex(in: contentLineCount ..< lineCount, text: text).map({ commentLineStarts[$0 - contentLineCount] })
+
+		updateFirstContentLineIndex(text: text, startingAt: 0)
+	}
+
+	// MARK: Private
+
+	private mutating func updateFirstContentLineIndex(text: NSString, startingAt startLineIndex: Int) {
+		firstContentLineIndex = findFirstContentLineIndex(in: startLineIndex ..< contentLineStarts.count, text: text)
+	}
+
+	private func findFirstContentLineIndex(in lineIndices: Range<Int>, text: NSString) -> Int? {
+		// Classifying is specialized for each built-in comment syntax
+		switch versionControlType {
+		case .git:
+			return findFirstContentLineIndex(in: lineIndices, text: text, commentSyntax: GitCommentSyntax())
+		case .hg:
+			return findFirstContentLineIndex(in: lineIndices, text: text, commentSyntax: HGCommentSyntax())
+		case .svn:
+			return findFirstContentLineIndex(in: lineIndices, text: text, commentSyntax: SVNCommentSyntax())
+		case .jj:
+			return findFirstContentLineIndex(in: lineIndices, text: text, commentSyntax: JJCommentSyntax())
+		case .custom(let commentSyntax):
+			return findFirstContentLineIndex(in: lineIndices, text: text, commentSyntax: commentSyntax)
+		}
+	}
+
+	private func findFirstContentLineIndex<Syntax: CommentSyntax>(in lineIndices: Range<Int>, text: NSString, commentSyntax: Syntax) -> Int? {
+		return lineIndices.first(where: { lineIndex in
+			let line = text.substring(with: lineRange(at: lineIndex, in: text))
+			return !commentSyntax.isCommentLine(line)
+		})
+	}
+
+	private static func lineEnd(in text: NSString, at location: UTF16Offset) -> UTF16Offset {
+		var lineStart = 0
+		var lineEnd = 0
+		var contentsEnd = 0
+		text.getLineStart(&lineStart, end: &lineEnd, contentsEnd: &contentsEnd, for: NSMakeRange(location, 0))
+		return lineEnd
+	}
+
+	// Matches the line separators recognized by NSString's getLineStart(_:end:contentsEnd:for:)
+	private static func isLineSeparator(_ character: unichar) -> Bool {
+		switch character {
+		case 0x0A, 0x0D, 0x85, 0x2028, 0x2029:
+			return true
+		default:
+			return false
+		}
+	}
+
+	// Binary search for the last index whose value is <= offset; offsets must be non-empty and begin at or before offset
+	private static func lastIndex(in offsets: [UTF16Offset], notGreaterThan offset: UTF16Offset) -> Int {
+		return max(firstIndex(in: offsets, notLessThan: offset + 1) - 1, 0)
+	}
+
+	// Binary search for the first index whose value is >= offset, or offsets.count if there is none
+	private static func firstIndex(in offsets: [UTF16Offset], notLessThan offset: UTF16Offset) -> Int {
+		var low = 0
+		var high = offsets.count
+		while low < high {
+			let middle = (low + high) / 2
+			if offsets[middle] < offset {
+				low = middle + 1
+			} else {
+				high = middle
+			}
+		}
+		return low
+	}
+}
@@ -0,0 +1,355 @@
+//
+//  CommitTextScanner.swift
+//  Komet
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import Foundation
+
+// UTF-8 offsets found by CommitTextScanner
+public typealias CommitTextLineOffsets = (commentSectionOffset: Int?, firstContentLineOffset: Int?, scissoredContentOffset: Int?)
+
+public struct CommitTextScan {
+	// Length of the comment section in UTF-16 code units
+	public let commentSectionLength: Int
+	public let firstContentLineIndex: String.Index?
+	public let commitTextRange: Range<String.Index>
+}
+
+// Scans commit text in a single pass over its UTF-8 code units without creating a String for every line.
+// Lines are broken the same way NSString's getLineStart(_:end:contentsEnd:for:) breaks them,
+// and comment and scissor markers are matched on raw bytes.
+// When a line has non-ASCII bytes next to a marker, grapheme clustering could change the result
+// (e.g. a combining mark after "#"), so we defer to the comment syntax's String based checks for that line.
+// The scanner is generic over the comment syntax so the fallbacks are specialized for the built-in syntaxes.
+public struct CommitTextScanner<Syntax: CommentSyntax> {
+	private static var chunkSize: Int { 16 }
+	private typealias Chunk = SIMD16<UInt8>
+
+	private let bytes: UnsafeBufferPointer<UInt8>
+	private let commentSyntax: Syntax
+
+	// The comment syntax is looked up once and its markers are kept as bytes for matching every line
+	private let commentPrefix: [UInt8]
+	private let commentSuffix: [UInt8]
+	// Markers from custom comment syntaxes may not be ASCII, in which case they could join a grapheme cluster with the rest of the line
+	private let hasASCIICommentMarkers: Bool
+	private let hasSingleCommentLineMarker: Bool
+	private let scissorRule: ScissorRule
+	private let scissorLinePrefix: [UInt8]
+	private let scissorLine: [UInt8]
+
+	private let scissorLineSuffix = Array("--".utf8)
+	private let scissorMarker = Array(">8".utf8)
+
+	private init(bytes: UnsafeBufferPointer<UInt8>, commentSyntax: Syntax) {
+		self.bytes = bytes
+		self.commentSyntax = commentSyntax
+
+		commentPrefix = Array(commentSyntax.prefix.utf8)
+		commentSuffix = Array(commentSyntax.suffix.utf8)
+		hasASCIICommentMarkers = commentPrefix.allSatisfy({ $0 < 0x80 }) && commentSuffix.allSatisfy({ $0 < 0x80 })
+		hasSingleCommentLineMarker = commentSyntax.hasSingleCommentLineMarker
+		scissorRule = commentSyntax.scissorRule
+
+		switch commentSyntax.scissorRule {
+		case .none:
+			scissorLinePrefix = []
+			scissorLine = []
+		case .scissors:
+			scissorLinePrefix = Array((commentSyntax.prefix + " --").utf8)
+			scissorLine = []
+		case .exactLine(let marker):
+			scissorLinePrefix = []
+			scissorLine = Array(marker.utf8)
+		}
+	}
+
+	public static func scanLines(bytes: UnsafeBufferPointer<UInt8>, commentSyntax: Syntax, findingCommentSection: Bool) -> CommitTextLineOffsets {
+		return CommitTextScanner(bytes: bytes, commentSyntax: commentSyntax).scanLines(findingCommentSection: findingCommentSection)
+	}
+
+	// MARK: Scanning
+
+	// Returns the UTF-8 offsets of the comment section (if found), the first content line (if found),
+	// and the content following the scissor line that ended the comment section (if found).
+	// See TextProcessor.commentSectionLength() and TextProcessor.firstContentLineIndex() for the rules.
+	private func scanLines(findingCommentSection: Bool) -> CommitTextLineOffsets {
+		let count = bytes.count
+
+		var lineStart = 0
+		var scanningCommentSection = findingCommentSection
+		var foundCommentSection = false
+		var commentSectionOffset = 0
+		var passedIntroCommentSection = false
+		var firstContentLineOffset: Int? = nil
+		var scissoredContentOffset: Int? = nil
+
+		while lineStart < count && (scanningCommentSection || firstContentLineOffset == nil) {
+			let (contentsEnd, lineEnd) = lineEnds(from: lineStart)
+
+			let commentLine = isCommentLine(lineStart ..< contentsEnd)
+			if !commentLine && firstContentLineOffset == nil {
+				firstContentLineOffset = lineStart
+			}
+
+			if scanningCommentSection {
+				if !commentLine {
+					if foundCommentSection && (!passedIntroCommentSection || !isBlankLine(lineStart ..< contentsEnd)) {
+						// If we found a non-comment line that is not empty, then we have to find a better starting point for the comment section
+						// If we found an empty line but have only just passed the intro comment section, then we need to find a better starting point for the comment section
+						foundCommentSection = false
+					}
+
+					passedIntroCommentSection = true
+				} else {
+					if !foundCommentSection {
+						foundCommentSection = true
+						commentSectionOffset = lineStart
+
+						// If there's only a single comment line marker, then we're done
+						if hasSingleCommentLineMarker {
+							scanningCommentSection = false
+						}
+					} else if isScissorLine(lineStart ..< contentsEnd) {
+						// Everything below the scissor line is non-editable content which will be part of the comment section
+						scanningCommentSection = false
+						scissoredContentOffset = lineEnd
+					}
+				}
+			}
+
+			lineStart = lineEnd
+		}
+
+		return (foundCommentSection ? commentSectionOffset : nil, firstContentLineOffset, scissoredContentOffset)
+	}
+
+	// Returns the end of the line's contents and the start of the next line,
+	// skipping a chunk at a time while no byte in the chunk could begin a line separator
+	// (\n, \r, \r\n, U+0085 (C2 85), U+2028 (E2 80 A8) or U+2029 (E2 80 A9))
+	private func lineEnds(from lineStart: Int) -> (contentsEnd: Int, lineEnd: Int) {
+		let count = bytes.count
+		let chunkSize = Self.chunkSize
+
+		var index = lineStart
+		while index < count {
+			if index + chunkSize <= count {
+				let chunk = UnsafeRawPointer(bytes.baseAddress! + index).loadUnaligned(as: Chunk.self)
+				let candidates = (chunk .== Chunk(repeating: 0x0A)) .| (chunk .== Chunk(repeating: 0x0D)) .| (chunk .== Chunk(repeating: 0xC2)) .| (chunk .== Chunk(repeating: 0xE2))
+				if !any(candidates) {
+					index += chunkSize
+					continue
+				}
+			}
+
+			let chunkEnd = min(index + chunkSize, count)
+			while index < chunkEnd {
+				switch bytes[index] {
+				case 0x0A:
+					return (index, index + 1)
+				case 0x0D:
+					return (index, (index + 1 < count && bytes[index + 1] == 0x0A) ? index + 2 : index + 1)
+				case 0xC2:
+					if index + 1 < count && bytes[index + 1] == 0x85 {
+						return (index, index + 2)
+					}
+				case 0xE2:
+					if index + 2 < count && bytes[index + 1] == 0x80 && (bytes[index + 2] == 0xA8 || bytes[index + 2] == 0xA9) {
+						return (index, index + 3)
+					}
+				default:
+					break
+				}
+				index += 1
+			}
+		}
+
+		return (count, count)
+	}
+
+	// MARK: Line Matching
+
+	private func isCommentLine(_ line: Range<Int>) -> Bool {
+		let prefixLength = commentPrefix.count
+		let suffixLength = commentSuffix.count
+
+		// A line with fewer bytes than the markers can't have enough characters either
+		guard line.count >= prefixLength + suffixLength, hasPrefix(commentPrefix, line), hasSuffix(commentSuffix, line) else {
+			return false
+		}
+
+		let afterPrefixIndex = line.lowerBound + prefixLength
+		let beforeSuffixIndex = line.upperBound - suffixLength - 1
+		if !hasASCIICommentMarkers || (afterPrefixIndex < line.upperBound && bytes[afterPrefixIndex] >= 0x80) || (suffixLength > 0 && bytes[beforeSuffixIndex] >= 0x80) {
+			return commentSyntax.isCommentLine(string(line))
+		}
+
+		return true
+	}
+
+	private func isScissorLine(_ line: Range<Int>) -> Bool {
+		switch scissorRule {
+		case .none:
+			return false
+		case .scissors:
+			guard hasPrefix(scissorLinePrefix, line) else {
+				return false
+			}
+
+			guard isASCII(line) else {
+				return commentSyntax.isScissorLine(string(line))
+			}
+
+			return hasSuffix(scissorLineSuffix, line) && contains(scissorMarker, line)
+		case .exactLine:
+			return line.count == scissorLine.count && hasPrefix(scissorLine, line)
+		}
+	}
+
+	// Equivalent to checking line.trimmingCharacters(in: .whitespacesAndNewlines).count == 0
+	private func isBlankLine(_ line: Range<Int>) -> Bool {
+		for index in line {
+			let byte = bytes[index]
+			if byte >= 0x80 {
+				return string(line).trimmingCharacters(in: .whitespacesAndNewlines).count == 0
+			}
+
+			if byte != 0x20 && !(0x09 ... 0x0D).contains(byte) {
+				return false
+			}
+		}
+		return true
+	}
+
+	// MARK: Byte Helpers
+
+	private func hasPrefix(_ prefix: [UInt8], _ line: Range<Int>) -> Bool {
+		let prefixLength = prefix.count
+		guard prefixLength > 0 else {
+			return true
+		}
+		guard line.count >= prefixLength else {
+			return false
+		}
+		return memcmp(bytes.baseAddress! + line.lowerBound, prefix, prefixLength) == 0
+	}
+
+	private func hasSuffix(_ suffix: [UInt8], _ line: Range<Int>) -> Bool {
+		let suffixLength = suffix.count
+		guard suffixLength > 0 else {
+			return true
+		}
+		guard line.count >= suffixLength else {
+			return false
+		}
+		return memcmp(bytes.baseAddress! + line.upperBound - suffixLength, suffix, suffixLength) == 0
+	}
+
+	private func contains(_ needle: [UInt8], _ line: Range<Int>) -> Bool {
+		let needleLength = needle.count
+		guard line.count >= needleLength else {
+			return false
+		}
+
+		for index in line.lowerBound ... line.upperBound - needleLength {
+			if memcmp(bytes.baseAddress! + index, needle, needleLength) == 0 {
+				return true
+			}
+		}
+		return false
+	}
+
+	private func isASCII(_ line: Range<Int>) -> Bool {
+		let chunkSize = Self.chunkSize
+
+		var index = line.lowerBound
+		var combinedChunk = Chunk(repeating: 0)
+		while index + chunkSize <= line.upperBound {
+			combinedChunk |= UnsafeRawPointer(bytes.baseAddress! + index).loadUnaligned(as: Chunk.self)
+			index += chunkSize
+		}
+
+		var combinedByte = combinedChunk.max()
+		while index < line.upperBound {
+			combinedByte |= bytes[index]
+			index += 1
+		}
+
+		return combinedByte < 0x80
+	}
+
+	private func string(_ line: Range<Int>) -> String {
+		return String(decoding: UnsafeBufferPointer(rebasing: bytes[line]), as: UTF8.self)
+	}
+}
+
+extension TextProcessor {
+	// Scanning is specialized for each built-in comment syntax
+	public static func scanLines(bytes: UnsafeBufferPointer<UInt8>, versionControlType: VersionControlType, findingCommentSection: Bool) -> CommitTextLineOffsets {
+		switch versionControlType {
+		case .git:
+			return CommitTextScanner.scanLines(bytes: bytes, commentSyntax: GitCommentSyntax(), findingCommentSection: findingCommentSection)
+		case .hg:
+			return CommitTextScanner.scanLines(bytes: bytes, commentSyntax: HGCommentSyntax(), findingCommentSection: findingCommentSection)
+		case .svn:
+			return CommitTextScanner.scanLines(bytes: bytes, commentSyntax: SVNCommentSyntax(), findingCommentSection: findingCommentSection)
+		case .jj:
+			return CommitTextScanner.scanLines(bytes: bytes, commentSyntax: JJCommentSyntax(), findingCommentSection: findingCommentSection)
+		case .custom(let commentSyntax):
+			return CommitTextScanner.scanLines(bytes: bytes, commentSyntax: commentSyntax, findingCommentSection: findingCommentSection)
+		}
+	}
+
+	public static func scanLines(plainText: String, versionControlType: VersionControlType, findingCommentSection: Bool) -> CommitTextLineOffsets {
+		// Bridged strings may not have contiguous UTF-8 storage available
+		var contiguousText = plainText
+		contiguousText.makeContiguousUTF8()
+
+		return contiguousText.utf8.withContiguousStorageIfAvailable { bytes in
+			return scanLines(bytes: bytes, versionControlType: versionControlType, findingCommentSection: findingCommentSection)
+		}!
+	}
+
+	// Computes the comment section length, first content line, and commit text range in a single pass.
+	// This produces the same results as calling commentSectionLength(), firstContentLineIndex(), and commitTextRange() separately.
+	public static func scanCommitText(plainText: String, versionControlType: VersionControlType) -> CommitTextScan {
+		let (commentSectionOffset, firstContentLineOffset, _) = scanLines(plainText: plainText, versionControlType: versionControlType, findingCommentSection: true)
+
+		let utf8View = plainText.utf8
+		let commentSectionIndex = commentSectionOffset.map({ utf8View.index(utf8View.startIndex, offsetBy: $0) }) ?? utf8View.endIndex
+		let firstContentLineIndex = firstContentLineOffset.map({ utf8View.index(utf8View.startIndex, offsetBy: $0) })
+
+		let commentSectionLength = plainText.utf16.distance(from: commentSectionIndex, to: plainText.endIndex)
+		let commitTextEndIndex = Self.commitTextEndIndex(utf8View: utf8View, commentSectionIndex: commentSectionIndex)
+
+		return CommitTextScan(commentSectionLength: commentSectionLength, firstContentLineIndex: firstContentLineIndex, commitTextRange: plainText.startIndex ..< commitTextEndIndex)
+	}
+
+	// Walks backwards from the comment section over at most two "\n" characters.
+	// Note a "\r\n" pair is a single Character which is not equal to "\n", so it is not skipped.
+	public static func commitTextEndIndex(utf8View: String.UTF8View, commentSectionIndex: String.Index) -> String.Index {
+		let startIndex = utf8View.startIndex
+		var bestEndIndex = commentSectionIndex
+
+		var passedNewline = false
+		while bestEndIndex > startIndex {
+			let priorIndex = utf8View.index(before: bestEndIndex)
+			guard utf8View[priorIndex] == 0x0A, priorIndex == startIndex || utf8View[utf8View.index(before: priorIndex)] != 0x0D else {
+				break
+			}
+
+			bestEndIndex = priorIndex
+
+			if passedNewline {
+				break
+			} else {
+				passedNewline = true
+			}
+		}
+
+		return bestEndIndex
+	}
+}
@@ -0,0 +1,253 @@
+//
+//  LaunchPipeline.swift
+//  Komet
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import Foundation
+
+public enum LaunchPipelineError: LocalizedError {
+	case invalidUTF8
+
+	public var errorDescription: String? {
+		switch self {
+		case .invalidUTF8:
+			return "The commit file could not be read because it is not valid UTF-8."
+		}
+	}
+}
+
+// Everything the editor needs from the commit file before it can populate its text storage
+public struct LoadedCommit {
+	public let versionControlType: VersionControlType
+	// Differs from versionControlType for hg squash messages
+	public let commentVersionControlType: VersionControlType
+	public let isSquashMessage: Bool
+	// Includes the resumed incomplete commit message if there was one
+	public let initialPlainText: String
+	public let commentSectionLength: Int
+	public let initialCommitTextRange: Range<String.UTF16View.Index>
+	// nil if there's no comment section to classify
+	public let commentSectionHighlights: CommentSectionHighlights?
+	public let resumedFromSavedCommit: Bool
+	public let collapsedScissoredContent: CollapsedScissoredContent?
+	public let initiallyContainedEmptyContent: Bool
+	public let initiallyContainedEmptyCommentIntroLine: Bool
+}
+
+// Reads and parses the commit file, and looks up an incomplete commit message saved by a canceled session, on background queues.
+// This work overlaps with the editor building its window and views, and the editor joins with the results
+// right before it populates its text storage.
+public final class LaunchPipeline {
+	public struct Options {
+		public var versionControlledFile = true
+		// Otherwise git is assumed, like in tutorial mode
+		public var detectsVersionControlType = true
+		public var customCommentSyntaxesURL: URL? = nil
+		public var detectHGCommentStyleForSquashes = true
+		// 0 to never collapse scissored content
+		public var collapseThreshold = 0
+		public var previewLength = 0
+		// nil if incomplete commit messages shouldn't be resumed from
+		public var savedCommitMessageURL: URL? = nil
+		public var savedCommitMessageTimeoutInterval: TimeInterval = 0
+
+		public init() {
+		}
+	}
+
+	public let trace: LaunchTrace
+
+	private let stagesGroup = DispatchGroup()
+	private let readyGroup = DispatchGroup()
+
+	// These are written on background queues before leaving the groups that are waited on to read them
+	private var parsedCommit: Result<LoadedCommit, Error>!
+	private var savedCommitMessage: String?
+	private var loadedCommit: Result<LoadedCommit, Error>!
+
+	public init(fileURL: URL, options: Options, trace: LaunchTrace = LaunchTrace(), queue: DispatchQueue = .global(qos: .userInitiated)) {
+		self.trace = trace
+
+		readyGroup.enter()
+
+		queue.async(group: stagesGroup) {
+			self.parsedCommit = Result(catching: {
+				return try Self.parse(fileURL: fileURL, options: options, trace: trace)
+			})
+		}
+
+		if let savedCommitMessageURL = options.savedCommitMessageURL {
+			queue.async(group: stagesGroup) {
+				self.savedCommitMessage = trace.measure("Look up saved commit message") {
+					return Self.lookUpSavedCommitMessage(at: savedCommitMessageURL, timeoutInterval: options.savedCommitMessageTimeoutInterval)
+				}
+			}
+		}
+
+		stagesGroup.notify(queue: queue) {
+			self.loadedCommit = self.parsedCommit!.map({ parsedCommit in
+				return Self.resume(parsedCommit, savedCommitMessage: self.savedCommitMessage, trace: trace)
+			})
+			self.readyGroup.leave()
+		}
+	}
+
+	// Blocks until the commit file has been loaded. This can be called more than once.
+	public func wait() throws -> LoadedCommit {
+		trace.measure("Wait for commit file") {
+			readyGroup.wait()
+		}
+		return try loadedCommit!.get()
+	}
+
+	// MARK: Stages
+
+	private static func parse(fileURL: URL, options: Options, trace: LaunchTrace) throws -> LoadedCommit {
+		// The commit file is memory mapped so we can inspect it without copying all of its contents
+		let commitFile = try trace.measure("Read commit file") {
+			return try CommitFile(contentsOf: fileURL)
+		}
+
+		let versionControlType = trace.measure("Detect version control") { () -> VersionControlType in
+			guard options.detectsVersionControlType else {
+				return .git
+			}
+			return TextProcessor.versionControlType(fileURL: fileURL, customCommentSyntaxes: loadCustomCommentSyntaxes(at: options.customCommentSyntaxesURL))
+		}
+
+		let isSquashMessage = trace.measure("Detect squash message") {
+			return TextProcessor.isSquashMessage(fileURL: fileURL, commitFile: commitFile, versionControlType: versionControlType)
+		}
+
+		let commentVersionControlType = TextProcessor.commentVersionControlType(versionControlType: versionControlType, isSquashMessage: isSquashMessage, detectHGCommentStyleForSquashes: options.detectHGCommentStyleForSquashes)
+
+		let (plainText, collapsedScissoredContent) = try trace.measure("Load commit text") { () throws -> (String, CollapsedScissoredContent?) in
+			guard let (plainStringCandidate, collapsedContentCandidate) = commitFile.loadText(versionControlType: commentVersionControlType, collapseThreshold: options.collapseThreshold, previewLength: options.previewLength, placeholder: { collapsedByteCount in
+				return TextProcessor.commentLine(CollapsedScissoredContent.placeholderDescription(collapsedByteCount: collapsedByteCount), versionControlType: commentVersionControlType)
+			}) else {
+				throw LaunchPipelineError.invalidUTF8
+			}
+
+			// It's unlikely we'll get content that has no line break, but if we do,
+			// just insert a newline character because Komet won't be able to deal with the content otherwise
+			guard commitFile.containsLineBreak else {
+				return ("\n", nil)
+			}
+			return (plainStringCandidate, collapsedContentCandidate)
+		}
+
+		let (commentSectionLength, commitTextRange) = trace.measure("Scan commit text") { () -> (Int, Range<String.UTF16View.Index>) in
+			guard options.versionControlledFile else {
+				return (0, TextProcessor.commitTextRange(plainText: plainText, commentLength: 0))
+			}
+			let scan = TextProcessor.scanCommitText(plainText: plainText, versionControlType: commentVersionControlType)
+			return (scan.commentSectionLength, scan.commitTextRange)
+		}
+
+		let commentSectionHighlights = trace.measure("Classify comment section") {
+			return Self.commentSectionHighlights(plainText: plainText, commentSectionLength: commentSectionLength, versionControlType: commentVersionControlType)
+		}
+
+		// Detect if there's empty content
+		// Note: Some jj message templates have a comment intro (like 'split')
+		// In these cases, we track these messages as not having empty content initially,
+		// but also track it as initially containing just an intro comment line and nothing else
+		let initiallyContainedEmptyContent: Bool
+		let initiallyContainedEmptyCommentIntroLine: Bool
+		let trimmedContent = plainText[commitTextRange.lowerBound ..< commitTextRange.upperBound].trimmingCharacters(in: .newlines)
+		if trimmedContent.count == 0 {
+			initiallyContainedEmptyContent = true
+			initiallyContainedEmptyCommentIntroLine = false
+		} else if trimmedContent.contains(where: { $0.isNewline }) {
+			// There must be more non-empty content after the newline
+			initiallyContainedEmptyContent = false
+			initiallyContainedEmptyCommentIntroLine = false
+		} else {
+			let hasIntroCommentLine = TextProcessor.isCommentLine(trimmedContent, versionControlType: commentVersionControlType)
+			initiallyContainedEmptyContent = hasIntroCommentLine
+			initiallyContainedEmptyCommentIntroLine = hasIntroCommentLine
+		}
+
+		return LoadedCommit(versionControlType: versionControlType, commentVersionControlType: commentVersionControlType, isSquashMessage: isSquashMessage, initialPlainText: plainText, commentSectionLength: commentSectionLength, initialCommitTextRange: commitTextRange, commentSectionHighlights: commentSectionHighlights, resumedFromSavedCommit: false, collapsedScissoredContent: collapsedScissoredContent, initiallyContainedEmptyContent: initiallyContainedEmptyContent, initiallyContainedEmptyCommentIntroLine: initiallyContainedEmptyCommentIntroLine)
+	}
+
+	// The comment section can't be edited, so its lines are classified once here rather than while the editor styles each paragraph
+	private static func commentSectionHighlights(plainText: String, commentSectionLength: Int, versionControlType: VersionControlType) -> CommentSectionHighlights? {
+		guard commentSectionLength > 0 else {
+			return nil
+		}
+
+		let commentSectionIndex = TextProcessor.commentSectionIndex(plainUTF16Text: plainText.utf16, commentSectionLength: commentSectionLength)
+		return CommentSectionHighlights(commentSectionText: String(plainText[commentSectionIndex...]), versionControlType: versionControlType)
+	}
+
+	private static func loadCustomCommentSyntaxes(at fileURL: URL?) -> [CustomCommentSyntax] {
+		guard let fileURL, FileManager.default.fileExists(atPath: fileURL.path) else {
+			return []
+		}
+
+		do {
+			return try CustomCommentSyntax.load(contentsOf: fileURL)
+		} catch {
+			print("Failed to load comment syntaxes: \(error)")
+			return []
+		}
+	}
+
+	// Runs before we know if the commit file has empty content, so whether the message is resumed from is decided afterwards
+	private static func lookUpSavedCommitMessage(at fileURL: URL, timeoutInterval: TimeInterval) -> String? {
+		let fileManager = FileManager()
+		guard fileManager.fileExists(atPath: fileURL.path) else {
+			return nil
+		}
+
+		defer {
+			// Always remove the last commit file on every launch
+			let _ = try? fileManager.removeItem(at: fileURL)
+		}
+
+		do {
+			let resource = try fileURL.resourceValues(forKeys: [.attributeModificationDateKey])
+			let lastModifiedDate = resource.attributeModificationDate
+
+			// Use a timeout interval for using the last incomplete commit message
+			// If too much time passes by, chances are the user may want to start anew
+			let intervalSinceLastSavedCommitMessage = lastModifiedDate.flatMap({ Date().timeIntervalSince($0) }) ?? 0.0
+			guard intervalSinceLastSavedCommitMessage >= 0.0 && intervalSinceLastSavedCommitMessage <= timeoutInterval else {
+				return nil
+			}
+
+			return try String(contentsOf: fileURL, encoding: .utf8)
+		} catch {
+			print("Failed to load last saved commit message: \(error)")
+			return nil
+		}
+	}
+
+	// The incomplete commit message is only resumed from if the commit file initially had no content
+	private static func resume(_ parsedCommit: LoadedCommit, savedCommitMessage: String?, trace: LaunchTrace) -> LoadedCommit {
+		guard let savedCommitMessage, parsedCommit.initiallyContainedEmptyContent && !parsedCommit.initiallyContainedEmptyCommentIntroLine else {
+			return parsedCommit
+		}
+
+		let initialPlainText = savedCommitMessage.appending(parsedCommit.initialPlainText)
+		let scan = trace.measure("Scan resumed commit text") {
+			return TextProcessor.scanCommitText(plainText: initialPlainText, versionControlType: parsedCommit.commentVersionControlType)
+		}
+
+		// The resumed message is inserted before the comment section, which only needs to be classified again if the scan found a different one
+		let commentSectionHighlights: CommentSectionHighlights?
+		if scan.commentSectionLength == parsedCommit.commentSectionLength {
+			commentSectionHighlights = parsedCommit.commentSectionHighlights
+		} else {
+			commentSectionHighlights = trace.measure("Classify resumed comment section") {
+				return Self.commentSectionHighlights(plainText: initialPlainText, commentSectionLength: scan.commentSectionLength, versionControlType: parsedCommit.commentVersionControlType)
+			}
+		}
+
+		return LoadedCommit(versionControlType: parsedCommit.versionControlType, commentVersionControlType: parsedCommit.commentVersionControlType, isSquashMessage: parsedCommit.isSquashMessage, initialPlainText: initialPlainText, commentSectionLength: scan.commentSectionLength, initialCommitTextRange: scan.commitTextRange, commentSectionHighlights: commentSectionHighlights, resumedFromSavedCommit: true, collapsedScissoredContent: parsedCommit.collapsedScissoredContent, initiallyContainedEmptyContent: parsedCommit.initiallyContainedEmptyContent, initiallyContainedEmptyCommentIntroLine: parsedCommit.initiallyContainedEmptyCommentIntroLine)
+	}
+}
@@ -0,0 +1,76 @@
+//
+//  LaunchTrace.swift
+//  Komet
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import Foundation
+#if canImport(os)
+import os
+#endif
+
+// Records how long each stage of launching the editor takes, including stages that run concurrently.
+// On Apple platforms every stage is also a signpost interval so launches can be inspected in Instruments.
+public final class LaunchTrace {
+	public struct Interval: Encodable {
+		public let stage: String
+		// In milliseconds since the trace was created
+		public let start: Double
+		public let duration: Double
+	}
+
+	private let startTime = DispatchTime.now().uptimeNanoseconds
+	private let lock = NSLock()
+	private var recordedIntervals: [Interval] = []
+
+#if canImport(os)
+	private let signposter = OSSignposter(subsystem: "org.zgcoder.Komet", category: "Launch")
+#endif
+
+	public init() {
+	}
+
+	// Intervals are in the order their stages finished
+	public var intervals: [Interval] {
+		lock.lock()
+		defer {
+			lock.unlock()
+		}
+		return recordedIntervals
+	}
+
+	@discardableResult
+	public func measure<Value>(_ stage: StaticString, _ body: () throws -> Value) rethrows -> Value {
+#if canImport(os)
+		let signpostState = signposter.beginInterval(stage, id: signposter.makeSignpostID())
+		defer {
+			signposter.endInterval(stage, signpostState)
+		}
+#endif
+		let stageStartTime = DispatchTime.now().uptimeNanoseconds
+		defer {
+			record(stage: stage.description, startTime: stageStartTime, endTime: DispatchTime.now().uptimeNanoseconds)
+		}
+
+		return try body()
+	}
+
+	// Marks a moment that has no duration, like the editor becoming ready for typing
+	public func mark(_ event: StaticString) {
+#if canImport(os)
+		signposter.emitEvent(event)
+#endif
+		let time = DispatchTime.now().uptimeNanoseconds
+		record(stage: event.description, startTime: time, endTime: time)
+	}
+
+	private func record(stage: String, startTime: UInt64, endTime: UInt64) {
+		let interval = Interval(stage: stage, start: Double(startTime - self.startTime) / 1_000_000, duration: Double(endTime - startTime) / 1_000_000)
+
+		lock.lock()
+		recordedIntervals.append(interval)
+		lock.unlock()
+	}
+}
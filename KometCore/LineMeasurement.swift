@@ -0,0 +1,140 @@
+//
+//  LineMeasurement.swift
+//  Komet
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import Foundation
+
+// Measures lines in characters (grapheme clusters), which is how the subject and body length limits are counted.
+// Most commit messages are ASCII, where every UTF-16 code unit is a character except for a "\r\n" pair.
+// Those lines are measured from their length after a vectorized check of their code units,
+// and only lines with other characters need to be segmented into grapheme clusters.
+public struct LineMeasurement {
+	private static let chunkSize = 16
+
+	// The number of characters in the line
+	public static func columnCount(line: String) -> Int {
+		return asciiColumnCount(line: line) ?? line.count
+	}
+
+	// The range of the line past the length limit (in characters), relative to the start of the line
+	public static func overflowUTF16Range(line: String, lengthLimit: Int) -> NSRange? {
+		// A line can't have more characters than UTF-16 code units, which we can usually count without visiting the line
+		let utf16Count = line.utf16.count
+		guard utf16Count > lengthLimit else {
+			return nil
+		}
+
+		if let columnCount = asciiColumnCount(line: line) {
+			guard columnCount > lengthLimit else {
+				return nil
+			}
+			// Any "\r\n" is at the end of the line, so the characters up to the limit are single code units
+			return NSMakeRange(lengthLimit, utf16Count - lengthLimit)
+		}
+
+		// Only walk as many characters as the limit rather than measuring the entire line
+		guard let overflowIndex = line.index(line.startIndex, offsetBy: lengthLimit, limitedBy: line.endIndex), overflowIndex != line.endIndex else {
+			return nil
+		}
+		return TextProcessor.convertToUTF16Range(range: overflowIndex ..< line.endIndex, in: line)
+	}
+
+	// Returns nil if the line has characters that may need grapheme segmentation to be counted
+	public static func asciiColumnCount(line: String) -> Int? {
+		if let columnCount = line.utf8.withContiguousStorageIfAvailable(asciiColumnCount(codeUnits:)) {
+			return columnCount
+		}
+
+#if canImport(Darwin)
+		// Bridged strings (like the text storage's paragraphs) don't have contiguous UTF-8 storage,
+		// so we check the code units the string already has instead of transcoding a copy of the line
+		return asciiColumnCount(bridgedLine: line as CFString)
+#else
+		var contiguousLine = line
+		contiguousLine.makeContiguousUTF8()
+		return contiguousLine.utf8.withContiguousStorageIfAvailable(asciiColumnCount(codeUnits:))!
+#endif
+	}
+
+#if canImport(Darwin)
+	private static let bridgedChunkLength = 256
+
+	private static func asciiColumnCount(bridgedLine line: CFString) -> Int? {
+		let length = CFStringGetLength(line)
+
+		if let characters = CFStringGetCharactersPtr(line) {
+			return asciiColumnCount(codeUnits: UnsafeBufferPointer(start: characters, count: length))
+		}
+
+		// The pointer is only available if the string is stored as 8-bit code units; other encodings are rejected by the check for non-ASCII bytes
+		if let cString = CFStringGetCStringPtr(line, CFStringBuiltInEncodings.ASCII.rawValue) {
+			return cString.withMemoryRebound(to: UInt8.self, capacity: length) { bytes in
+				return asciiColumnCount(codeUnits: UnsafeBufferPointer(start: bytes, count: length))
+			}
+		}
+
+		// Otherwise read the line a chunk at a time into a buffer on the stack
+		let endsWithCRLF = length >= 2 && CFStringGetCharacterAtIndex(line, length - 2) == 0x0D && CFStringGetCharacterAtIndex(line, length - 1) == 0x0A
+		let checkedLength = endsWithCRLF ? length - 2 : length
+		let bridgedChunkLength = Self.bridgedChunkLength
+
+		return withUnsafeTemporaryAllocation(of: UniChar.self, capacity: bridgedChunkLength) { buffer -> Int? in
+			var location = 0
+			while location < checkedLength {
+				let chunkLength = min(bridgedChunkLength, checkedLength - location)
+				CFStringGetCharacters(line, CFRangeMake(location, chunkLength), buffer.baseAddress!)
+				guard isASCIIWithoutCarriageReturn(codeUnits: UnsafeBufferPointer(rebasing: buffer[0 ..< chunkLength])) else {
+					return nil
+				}
+				location += chunkLength
+			}
+			return endsWithCRLF ? length - 1 : length
+		}
+	}
+#endif
+
+	// A line is only treated as ASCII if it has no "\r" other than in a trailing "\r\n",
+	// which is the only pair of ASCII characters that forms a single grapheme cluster
+	// The code units may be UTF-8 or UTF-16, which are the same for ASCII characters
+	private static func asciiColumnCount<CodeUnit: FixedWidthInteger & SIMDScalar>(codeUnits: UnsafeBufferPointer<CodeUnit>) -> Int? {
+		let count = codeUnits.count
+		let endsWithCRLF = count >= 2 && codeUnits[count - 2] == 0x0D && codeUnits[count - 1] == 0x0A
+		let checkedCount = endsWithCRLF ? count - 2 : count
+
+		guard isASCIIWithoutCarriageReturn(codeUnits: UnsafeBufferPointer(rebasing: codeUnits[0 ..< checkedCount])) else {
+			return nil
+		}
+
+		return endsWithCRLF ? count - 1 : count
+	}
+
+	private static func isASCIIWithoutCarriageReturn<CodeUnit: FixedWidthInteger & SIMDScalar>(codeUnits: UnsafeBufferPointer<CodeUnit>) -> Bool {
+		typealias Chunk = SIMD16<CodeUnit>
+
+		let count = codeUnits.count
+		let chunkSize = Self.chunkSize
+
+		var index = 0
+		while index + chunkSize <= count {
+			let chunk = UnsafeRawPointer(codeUnits.baseAddress! + index).loadUnaligned(as: Chunk.self)
+			if any((chunk .>= Chunk(repeating: 0x80)) .| (chunk .== Chunk(repeating: 0x0D))) {
+				return false
+			}
+			index += chunkSize
+		}
+
+		while index < count {
+			let codeUnit = codeUnits[index]
+			if codeUnit >= 0x80 || codeUnit == 0x0D {
+				return false
+			}
+			index += 1
+		}
+
+		return true
+	}
+}
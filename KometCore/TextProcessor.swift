@@ -0,0 +1,197 @@
+//
+//  TextProcessor.swift
+//  Komet
+//
+//  Created by Mayur Pawashe on 6/21/25.
+//  Copyright © 2025 zgcoder. All rights reserved.
+//
+
+import Foundation
+
+public enum VersionControlType: Equatable {
+	case git
+	case hg
+	case svn
+	case jj
+	// Described by the user's comment syntaxes file
+	indirect case custom(CustomCommentSyntax)
+
+	public var commentSyntax: any CommentSyntax {
+		switch self {
+		case .git:
+			return GitCommentSyntax()
+		case .hg:
+			return HGCommentSyntax()
+		case .svn:
+			return SVNCommentSyntax()
+		case .jj:
+			return JJCommentSyntax()
+		case .custom(let syntax):
+			return syntax
+		}
+	}
+}
+
+public enum FileChangeType: String, Equatable, Decodable {
+	case added
+	case deleted
+	case modified
+}
+
+public struct TextProcessor {
+	public static func isConfigFile(_ fileURL: URL) -> Bool {
+		let filePathExtension = fileURL.pathExtension
+		let fileLastPathComponent = fileURL.lastPathComponent
+		
+		return filePathExtension == "toml" || fileLastPathComponent == ".gitconfig" || fileLastPathComponent == ".hgrc"
+	}
+
+	// Detect version control type from the location and name of the commit file
+	// Custom comment syntaxes that match the file take precedence
+	public static func versionControlType(fileURL: URL, customCommentSyntaxes: [CustomCommentSyntax]) -> VersionControlType {
+		if let customCommentSyntax = CustomCommentSyntax.matching(fileURL: fileURL, in: customCommentSyntaxes) {
+			return .custom(customCommentSyntax)
+		}
+		return versionControlType(fileURL: fileURL)
+	}
+
+	public static func versionControlType(fileURL: URL) -> VersionControlType {
+		// We don't *have* to detect this for git because we could look at the current working directory first,
+		// but I want to rely on the current working directory as a last resort.
+		if fileURL.deletingLastPathComponent().lastPathComponent == ".git" {
+			return .git
+		}
+
+		if fileURL.pathExtension == "jjdescription" {
+			return .jj
+		}
+
+		let lastPathComponent = fileURL.lastPathComponent
+		if lastPathComponent.hasPrefix("hg-") {
+			return .hg
+		} else if lastPathComponent.hasPrefix("svn-") {
+			return .svn
+		} else {
+			return .git
+		}
+	}
+
+	// Detect heuristically if this is a squash/rebase in git or hg
+	// Scan the entire file contents for simplicity and handle both git and hg (with histedit extension)
+	// Also test if the filename contains "rebase"
+	public static func isSquashMessage(fileURL: URL, commitFile: CommitFile, versionControlType: VersionControlType) -> Bool {
+		switch versionControlType {
+		case .hg:
+			fallthrough
+		case .git:
+			return fileURL.lastPathComponent.contains("rebase") || commitFile.contains("= use commit")
+		case .svn:
+			fallthrough
+		case .jj:
+			return false
+		case .custom(let syntax):
+			return syntax.baseVersionControlType.map({ isSquashMessage(fileURL: fileURL, commitFile: commitFile, versionControlType: $0) }) ?? false
+		}
+	}
+
+	// hg squash messages may be formatted with git style comments, including for custom comment syntaxes based on hg
+	public static func commentVersionControlType(versionControlType: VersionControlType, isSquashMessage: Bool, detectHGCommentStyleForSquashes: Bool) -> VersionControlType {
+		guard isSquashMessage && detectHGCommentStyleForSquashes else {
+			return versionControlType
+		}
+
+		switch versionControlType {
+		case .hg:
+			return .git
+		case .git, .svn, .jj:
+			return versionControlType
+		case .custom(let syntax):
+			return (syntax.baseVersionControlType == .hg) ? .git : versionControlType
+		}
+	}
+
+	// MARK: Comment syntax conveniences
+	// These look up the comment syntax on every call, which is fine for checking a line or two.
+	// Code that checks every line should look up versionControlType.commentSyntax once and pass it to generic code,
+	// like CommentSectionHighlights.lineKind(_:commentSyntax:) and CommitLineClassifier do.
+
+	public static func commentMarkers(versionControlType: VersionControlType) -> (prefix: String, suffix: String) {
+		let commentSyntax = versionControlType.commentSyntax
+		return (commentSyntax.prefix, commentSyntax.suffix)
+	}
+	
+	public static func commentLine(_ text: String, versionControlType: VersionControlType) -> String {
+		return versionControlType.commentSyntax.commentLine(text)
+	}
+	
+	public static func isCommentLine(_ line: String, versionControlType: VersionControlType) -> Bool {
+		return versionControlType.commentSyntax.isCommentLine(line)
+	}
+	
+	@available(macOS 13, *)
+	public static func labelInCommentLine(_ line: String, versionControlType: VersionControlType) -> (String, Int)? {
+		return versionControlType.commentSyntax.labelInCommentLine(line)
+	}
+
+	public static func fileChangeType(label: String, versionControlType: VersionControlType) -> FileChangeType? {
+		return versionControlType.commentSyntax.fileChangeType(label: label)
+	}
+
+	public static func isScissorLine(_ line: String, versionControlType: VersionControlType) -> Bool {
+		return versionControlType.commentSyntax.isScissorLine(line)
+	}
+
+	public static func hasSingleCommentLineMarker(versionControlType: VersionControlType) -> Bool {
+		return versionControlType.commentSyntax.hasSingleCommentLineMarker
+	}
+
+	// Content below the scissor line may include a diff that we want to highlight
+	public static func highlightsScissoredDiffs(versionControlType: VersionControlType) -> Bool {
+		return versionControlType.commentSyntax.highlightsScissoredDiffs
+	}
+
+	// The comment range should begin at the line that starts with a comment string and extend to the end of the file.
+	// Additionally, there should be no content lines (i.e, non comment lines) within this section
+	// (exception: unless we're dealing with svn which only has a starting point for comments)
+	// This should only be computed once, before the user gets a chance to edit the content
+	public static func commentSectionLength(plainText: String, versionControlType: VersionControlType) -> Int {
+		return scanCommitText(plainText: plainText, versionControlType: versionControlType).commentSectionLength
+	}
+	
+	// Find the first commit line. The first lines may be comment lines, which
+	// we'll need to skip
+	public static func firstContentLineIndex(plainText: String, versionControlType: VersionControlType) -> String.Index? {
+		let firstContentLineOffset = scanLines(plainText: plainText, versionControlType: versionControlType, findingCommentSection: false).firstContentLineOffset
+		
+		let utf8View = plainText.utf8
+		return firstContentLineOffset.map({ utf8View.index(utf8View.startIndex, offsetBy: $0) })
+	}
+
+	// The content range should extend to before the comments, only allowing one trailing newline in between the comments and content
+	// Make sure to scan from the bottom to top
+	public static func commitTextRange(plainText: String, commentLength: Int) -> Range<String.UTF16View.Index> {
+		let utf16View = plainText.utf16
+		let commentSectionIndex = utf16View.index(utf16View.endIndex, offsetBy: -commentLength)
+		
+		return utf16View.startIndex ..< commitTextEndIndex(utf8View: plainText.utf8, commentSectionIndex: commentSectionIndex)
+	}
+
+	// The range of the line past the length limit (in characters), relative to the start of the line
+	// See LineMeasurement for how lines are measured without segmenting most of them into grapheme clusters
+	public static func overflowUTF16Range(line: String, lengthLimit: Int) -> NSRange? {
+		return LineMeasurement.overflowUTF16Range(line: line, lengthLimit: lengthLimit)
+	}
+
+	public static func convertToUTF16Range(range: Range<String.Index>, in string: String) -> NSRange {
+		return NSRange(range, in: string)
+	}
+	
+	public static func commentSectionIndex(plainUTF16Text: String.UTF16View, commentSectionLength: Int) -> String.UTF16View.Index {
+		return plainUTF16Text.index(plainUTF16Text.endIndex, offsetBy: -commentSectionLength)
+	}
+	
+	public static func commentUTF16Range(plainText: String, commentSectionLength: Int) -> NSRange {
+		let utf16View = plainText.utf16
+		return Self.convertToUTF16Range(range: commentSectionIndex(plainUTF16Text: utf16View, commentSectionLength: commentSectionLength) ..< utf16View.endIndex, in: plainText)
+	}
+}
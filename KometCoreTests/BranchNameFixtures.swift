@@ -0,0 +1,183 @@
+//
+//  BranchNameFixtures.swift
+//  KometCoreTests
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import Foundation
+import KometCore
+
+private let OBJECT_NAME = "2c1e3f8a9b7d6e5f4a3b2c1d0e9f8a7b6c5d4e3f"
+
+// A minimal repository layout that is written out when testing,
+// since repositories can't be checked into Komet's own repository
+struct BranchNameFixture {
+	let name: String
+	let versionControlType: VersionControlType
+	let directories: [String]
+	// Contents of files keyed by their path relative to the fixture
+	let files: [String: String]
+	// Directory relative to the fixture that the editor is launched from
+	let workingDirectory: String
+	let expectedResolution: BranchNameResolution
+
+	static let all: [BranchNameFixture] = [
+		BranchNameFixture(
+			name: "git-branch",
+			versionControlType: .git,
+			directories: [".git/objects", "src/komet"],
+			files: [
+				".git/HEAD": "ref: refs/heads/main\n",
+				".git/refs/heads/main": "\(OBJECT_NAME)\n"
+			],
+			workingDirectory: "src/komet",
+			expectedResolution: .resolved("main")
+		),
+		BranchNameFixture(
+			name: "git-packed-branch",
+			versionControlType: .git,
+			directories: [".git/objects", ".git/refs/heads"],
+			files: [
+				".git/HEAD": "ref: refs/heads/feature/packed\n",
+				".git/packed-refs": "# pack-refs with: peeled fully-peeled sorted \n\(OBJECT_NAME) refs/heads/feature/packed\n\(OBJECT_NAME) refs/tags/1.0\n"
+			],
+			workingDirectory: "",
+			expectedResolution: .resolved("feature/packed")
+		),
+		BranchNameFixture(
+			name: "git-detached-head",
+			versionControlType: .git,
+			directories: [".git/objects", ".git/refs/heads"],
+			files: [
+				".git/HEAD": "\(OBJECT_NAME)\n"
+			],
+			workingDirectory: "",
+			expectedResolution: .resolved("HEAD")
+		),
+		BranchNameFixture(
+			name: "git-unborn-branch",
+			versionControlType: .git,
+			directories: [".git/objects", ".git/refs/heads"],
+			files: [
+				".git/HEAD": "ref: refs/heads/main\n"
+			],
+			workingDirectory: "",
+			expectedResolution: .resolved(nil)
+		),
+		BranchNameFixture(
+			name: "git-worktree",
+			versionControlType: .git,
+			directories: ["repository/.git/objects", "worktree/src"],
+			files: [
+				"repository/.git/HEAD": "ref: refs/heads/main\n",
+				"repository/.git/refs/heads/main": "\(OBJECT_NAME)\n",
+				"repository/.git/refs/heads/topic": "\(OBJECT_NAME)\n",
+				"repository/.git/worktrees/topic/HEAD": "ref: refs/heads/topic\n",
+				"repository/.git/worktrees/topic/commondir": "../..\n",
+				"worktree/.git": "gitdir: ../repository/.git/worktrees/topic\n"
+			],
+			workingDirectory: "worktree/src",
+			expectedResolution: .resolved("topic")
+		),
+		// git shows heads/1.0 here, which is left to git
+		BranchNameFixture(
+			name: "git-ambiguous-branch",
+			versionControlType: .git,
+			directories: [".git/objects"],
+			files: [
+				".git/HEAD": "ref: refs/heads/1.0\n",
+				".git/refs/heads/1.0": "\(OBJECT_NAME)\n",
+				".git/refs/tags/1.0": "\(OBJECT_NAME)\n"
+			],
+			workingDirectory: "",
+			expectedResolution: .unresolved
+		),
+		// git shows heads/origin here because refs/remotes/origin/HEAD exists, which is left to git
+		BranchNameFixture(
+			name: "git-remote-named-branch",
+			versionControlType: .git,
+			directories: [".git/objects"],
+			files: [
+				".git/HEAD": "ref: refs/heads/origin\n",
+				".git/refs/heads/origin": "\(OBJECT_NAME)\n",
+				".git/refs/remotes/origin/HEAD": "ref: refs/remotes/origin/main\n",
+				".git/refs/remotes/origin/main": "\(OBJECT_NAME)\n"
+			],
+			workingDirectory: "",
+			expectedResolution: .unresolved
+		),
+		BranchNameFixture(
+			name: "git-packed-remote-branch",
+			versionControlType: .git,
+			directories: [".git/objects", ".git/refs/heads"],
+			files: [
+				".git/HEAD": "ref: refs/heads/upstream\n",
+				".git/packed-refs": "# pack-refs with: peeled fully-peeled sorted \n\(OBJECT_NAME) refs/heads/upstream\n\(OBJECT_NAME) refs/remotes/upstream/HEAD\n"
+			],
+			workingDirectory: "",
+			expectedResolution: .unresolved
+		),
+		// Without a remote HEAD, the remote's directory doesn't make the branch name ambiguous
+		BranchNameFixture(
+			name: "git-remote-directory-branch",
+			versionControlType: .git,
+			directories: [".git/objects"],
+			files: [
+				".git/HEAD": "ref: refs/heads/origin\n",
+				".git/refs/heads/origin": "\(OBJECT_NAME)\n",
+				".git/refs/remotes/origin/main": "\(OBJECT_NAME)\n"
+			],
+			workingDirectory: "",
+			expectedResolution: .resolved("origin")
+		),
+		BranchNameFixture(
+			name: "hg-branch",
+			versionControlType: .hg,
+			directories: ["src"],
+			files: [
+				".hg/requires": "store\n",
+				".hg/branch": "stable\n"
+			],
+			workingDirectory: "src",
+			expectedResolution: .resolved("stable")
+		),
+		BranchNameFixture(
+			name: "hg-default-branch",
+			versionControlType: .hg,
+			directories: [],
+			files: [
+				".hg/requires": "store\n"
+			],
+			workingDirectory: "",
+			expectedResolution: .resolved("default")
+		),
+		BranchNameFixture(
+			name: "jj",
+			versionControlType: .jj,
+			directories: [".jj/repo"],
+			files: [:],
+			workingDirectory: "",
+			expectedResolution: .resolved(nil)
+		)
+	]
+
+	// Writes the fixture into directoryURL and returns the working directory to resolve from
+	func write(to directoryURL: URL) throws -> URL {
+		let fixtureURL = directoryURL.appendingPathComponent(name, isDirectory: true)
+		let fileManager = FileManager.default
+
+		for directory in directories {
+			try fileManager.createDirectory(at: fixtureURL.appendingPathComponent(directory, isDirectory: true), withIntermediateDirectories: true)
+		}
+
+		for (path, contents) in files {
+			let fileURL = fixtureURL.appendingPathComponent(path)
+			try fileManager.createDirectory(at: fileURL.deletingLastPathComponent(), withIntermediateDirectories: true)
+			try Data(contents.utf8).write(to: fileURL)
+		}
+
+		return workingDirectory.isEmpty ? fixtureURL : fixtureURL.appendingPathComponent(workingDirectory, isDirectory: true)
+	}
+}
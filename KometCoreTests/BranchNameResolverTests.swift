@@ -0,0 +1,57 @@
+//
+//  BranchNameResolverTests.swift
+//  KometCoreTests
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import XCTest
+import KometCore
+import KometTestSupport
+
+class BranchNameResolverTests: XCTestCase {
+	// Don't let the environment the tests are run from point the resolver or tools at another repository
+	private let environment = ProcessInfo.processInfo.environment.filter({ !$0.key.hasPrefix("GIT_") })
+
+	private var temporaryDirectoryURL: URL!
+
+	override func setUpWithError() throws {
+		temporaryDirectoryURL = FileManager.default.temporaryDirectory.appendingPathComponent("KometCoreTests-\(UUID().uuidString)", isDirectory: true)
+		try FileManager.default.createDirectory(at: temporaryDirectoryURL, withIntermediateDirectories: true)
+	}
+
+	override func tearDownWithError() throws {
+		try FileManager.default.removeItem(at: temporaryDirectoryURL)
+	}
+
+	func testFixtures() throws {
+		for fixture in BranchNameFixture.all {
+			let workingDirectoryURL = try fixture.write(to: temporaryDirectoryURL)
+			let resolution = BranchNameResolver.resolve(versionControlType: fixture.versionControlType, workingDirectoryURL: workingDirectoryURL, environment: environment)
+			XCTAssertEqual(resolution, fixture.expectedResolution, "\(fixture.name): resolution does not match")
+		}
+	}
+
+	private func checkToolRepository(versionControlType: VersionControlType) throws {
+		guard let repository = ToolRepositoryFixture.create(versionControlType: versionControlType, in: temporaryDirectoryURL) else {
+			throw XCTSkip("\(versionControlType) is not installed")
+		}
+
+		let toolBranchName = BranchNameResolver.branchNameFromTool(versionControlType: versionControlType, workingDirectoryURL: repository.workingDirectoryURL, environment: environment)
+		XCTAssertEqual(toolBranchName, ToolRepositoryFixture.branchName, "\(repository.name): tool reported a different branch name")
+
+		// Repositories the resolver can't read (e.g. if git is configured to use reftable) fall back to the tool
+		if case .resolved(let branchName) = BranchNameResolver.resolve(versionControlType: versionControlType, workingDirectoryURL: repository.workingDirectoryURL, environment: environment) {
+			XCTAssertEqual(branchName, toolBranchName, "\(repository.name): resolved a different branch name than the tool")
+		}
+	}
+
+	func testMatchesGit() throws {
+		try checkToolRepository(versionControlType: .git)
+	}
+
+	func testMatchesHG() throws {
+		try checkToolRepository(versionControlType: .hg)
+	}
+}
@@ -0,0 +1,52 @@
+//
+//  BreadcrumbsAnalyzerTests.swift
+//  KometCoreTests
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import XCTest
+import KometCore
+
+// Expected breadcrumb counts for fixtures, matching the breadcrumbs checked by KometUITests
+private let EXPECTED_FIXTURE_BREADCRUMB_COUNTS: [String: [KeyPath<Breadcrumbs, Array<Range<UTF16Offset>>>: Int]] = [
+	"new-commit-scissor": [\.diffHeaderLineRanges: 11, \.diffAddLineRanges: 2, \.diffRemoveLineRanges: 7],
+	"amended-commit-scissor": [\.diffHeaderLineRanges: 6, \.diffAddLineRanges: 5, \.diffRemoveLineRanges: 0],
+	"new-description-amend-scissor.jjdescription": [\.diffHeaderLineRanges: 6, \.diffAddLineRanges: 5, \.diffRemoveLineRanges: 0],
+	"files-changed": [\.fileChangeModifiedLineRanges: 3, \.fileChangeAddedLineRanges: 2, \.fileChangeDeletedLineRanges: 1],
+	"files-changed.jjdescription": [\.fileChangeModifiedLineRanges: 3, \.fileChangeAddedLineRanges: 2, \.fileChangeDeletedLineRanges: 1],
+]
+
+class BreadcrumbsAnalyzerTests: XCTestCase {
+	func testFixtureBreadcrumbCounts() throws {
+		let fixtures = try CommitTextCorpus.fixtures()
+		XCTAssertFalse(fixtures.isEmpty, "No fixtures found at \(CommitTextCorpus.fixturesURL.path)")
+
+		for (name, expectedCounts) in EXPECTED_FIXTURE_BREADCRUMB_COUNTS {
+			guard let fixture = fixtures.first(where: { $0.name == name }) else {
+				XCTFail("\(name): fixture not found")
+				continue
+			}
+
+			let scan = TextProcessor.scanCommitText(plainText: fixture.text, versionControlType: fixture.versionControlType)
+			let analysis = BreadcrumbsAnalyzer.analyze(text: fixture.text, versionControlType: fixture.versionControlType, commentSectionLength: scan.commentSectionLength, options: BreadcrumbsAnalyzer.Options(isSquashMessage: fixture.isSquashMessage))
+
+			for (keyPath, expectedCount) in expectedCounts {
+				XCTAssertEqual(analysis.breadcrumbs[keyPath: keyPath].count, expectedCount, "\(name): \(keyPath) breadcrumb count does not match")
+			}
+		}
+	}
+
+	// Every line is classified, and the classification survives being run-length encoded
+	func testLineKinds() throws {
+		for commit in try CommitTextCorpus.all() {
+			let scan = TextProcessor.scanCommitText(plainText: commit.text, versionControlType: commit.versionControlType)
+			let lineIndex = CommitLineIndex(text: NSString(string: commit.text), versionControlType: commit.versionControlType, commentSectionLength: scan.commentSectionLength)
+			let analysis = BreadcrumbsAnalyzer.analyze(text: commit.text, versionControlType: commit.versionControlType, commentSectionLength: scan.commentSectionLength, options: BreadcrumbsAnalyzer.Options(isSquashMessage: commit.isSquashMessage))
+
+			XCTAssertEqual(analysis.lineKinds.count, lineIndex.lineCount, "\(commit.name): analyzed line count does not match the line index")
+			XCTAssertEqual(CommitLineKind.runLengthDecoded(CommitLineKind.runLengthEncoded(analysis.lineKinds)), analysis.lineKinds, "\(commit.name): run-length encoded line kinds do not decode to the same line kinds")
+		}
+	}
+}
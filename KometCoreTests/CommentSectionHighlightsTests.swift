@@ -0,0 +1,33 @@
+//
+//  CommentSectionHighlightsTests.swift
+//  KometCoreTests
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import XCTest
+import KometCore
+import KometTestSupport
+
+class CommentSectionHighlightsTests: XCTestCase {
+	func testSyntheticDiffLineCounts() {
+		for commit in CommitTextCorpus.syntheticCommits() {
+			guard let expectedDiffLineCounts = commit.expectedDiffLineCounts else {
+				continue
+			}
+
+			let scan = TextProcessor.scanCommitText(plainText: commit.text, versionControlType: commit.versionControlType)
+			let highlights = CommentSectionHighlights(commentSectionText: CommitTextCorpus.commentSectionText(commit.text, commentSectionLength: scan.commentSectionLength), versionControlType: commit.versionControlType)
+
+			var counts: [CommentSectionLineKind: Int] = [:]
+			for lineIndex in 0 ..< highlights.lineCount {
+				counts[highlights.lineKind(at: lineIndex)!, default: 0] += 1
+			}
+
+			XCTAssertEqual(counts[.diffHeader, default: 0], expectedDiffLineCounts.header, "\(commit.name): diff header line count does not match")
+			XCTAssertEqual(counts[.diffAdd, default: 0], expectedDiffLineCounts.add, "\(commit.name): diff add line count does not match")
+			XCTAssertEqual(counts[.diffRemove, default: 0], expectedDiffLineCounts.remove, "\(commit.name): diff remove line count does not match")
+		}
+	}
+}
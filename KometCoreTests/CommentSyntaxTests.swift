@@ -0,0 +1,32 @@
+//
+//  CommentSyntaxTests.swift
+//  KometCoreTests
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import XCTest
+import KometCore
+import KometTestSupport
+
+class CommentSyntaxTests: XCTestCase {
+	// hg squash messages may be formatted with git style comments, which applies to custom comment syntaxes based on hg too
+	func testSquashCommentVersionControlTypes() throws {
+		let hgCommentSyntax = try JSONDecoder().decode(CustomCommentSyntax.self, from: Data(#"{"name": "hg-custom", "filePatterns": ["*/hg-custom-*"], "versionControl": "hg", "commentPrefix": "HC:"}"#.utf8))
+
+		for versionControlType in [VersionControlType.hg, .custom(hgCommentSyntax)] {
+			XCTAssertEqual(TextProcessor.commentVersionControlType(versionControlType: versionControlType, isSquashMessage: true, detectHGCommentStyleForSquashes: true), .git, "\(versionControlType): squash messages should use git comments")
+			XCTAssertEqual(TextProcessor.commentVersionControlType(versionControlType: versionControlType, isSquashMessage: false, detectHGCommentStyleForSquashes: true), versionControlType, "\(versionControlType): messages should use their own comments")
+		}
+	}
+
+	// Synthetic commit file names are picked so each custom comment syntax is detected for its own files
+	func testDetectsCustomCommentSyntaxes() {
+		let directoryURL = URL(fileURLWithPath: "/tmp", isDirectory: true)
+		for commit in CommitTextCorpus.syntheticCommits() {
+			let fileURL = directoryURL.appendingPathComponent(commit.fileName)
+			XCTAssertEqual(TextProcessor.versionControlType(fileURL: fileURL, customCommentSyntaxes: SyntheticCommit.customCommentSyntaxes), commit.versionControlType, "\(commit.fileName): detected version control type does not match")
+		}
+	}
+}
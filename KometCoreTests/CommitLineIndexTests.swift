@@ -0,0 +1,98 @@
+//
+//  CommitLineIndexTests.swift
+//  KometCoreTests
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import XCTest
+import KometCore
+
+class CommitLineIndexTests: XCTestCase {
+	private func assertSameLines(_ lineIndex: CommitLineIndex, _ expectedLineIndex: CommitLineIndex, _ message: String, file: StaticString = #filePath, line: UInt = #line) {
+		XCTAssertEqual(lineIndex.length, expectedLineIndex.length, message, file: file, line: line)
+		XCTAssertEqual(lineIndex.lineCount, expectedLineIndex.lineCount, message, file: file, line: line)
+		XCTAssertEqual(lineIndex.firstContentLineLocation, expectedLineIndex.firstContentLineLocation, message, file: file, line: line)
+		guard lineIndex.lineCount == expectedLineIndex.lineCount else {
+			return
+		}
+
+		let mismatchedLine = (0 ..< lineIndex.lineCount).first(where: { lineIndex.lineStart(at: $0) != expectedLineIndex.lineStart(at: $0) })
+		XCTAssertNil(mismatchedLine, message, file: file, line: line)
+	}
+
+	func testLineIndexMatchesScan() throws {
+		for commit in try CommitTextCorpus.all() {
+			let utf16View = commit.text.utf16
+			let scan = TextProcessor.scanCommitText(plainText: commit.text, versionControlType: commit.versionControlType)
+			let lineIndex = CommitLineIndex(text: NSString(string: commit.text), versionControlType: commit.versionControlType, commentSectionLength: scan.commentSectionLength)
+			let highlights = CommentSectionHighlights(commentSectionText: CommitTextCorpus.commentSectionText(commit.text, commentSectionLength: scan.commentSectionLength), versionControlType: commit.versionControlType)
+
+			XCTAssertEqual(lineIndex.length, utf16View.count, "\(commit.name): line index length does not match")
+			XCTAssertEqual(lineIndex.commentSectionLocation, utf16View.count - scan.commentSectionLength, "\(commit.name): comment section location does not match")
+			XCTAssertEqual(lineIndex.firstContentLineLocation, scan.firstContentLineIndex.map({ utf16View.distance(from: utf16View.startIndex, to: $0) }), "\(commit.name): first content line does not match")
+			XCTAssertEqual(lineIndex.lineCount - lineIndex.contentLineCount, highlights.lineCount, "\(commit.name): comment section line count does not match the highlights")
+		}
+	}
+
+	// Type a new line at the start of the content and then remove it again
+	func testInsertingAndRemovingLine() throws {
+		let insertion = "Edited subject\n"
+		let insertionLength = insertion.utf16.count
+
+		for commit in try CommitTextCorpus.all() {
+			let scan = TextProcessor.scanCommitText(plainText: commit.text, versionControlType: commit.versionControlType)
+			let lineIndex = CommitLineIndex(text: NSString(string: commit.text), versionControlType: commit.versionControlType, commentSectionLength: scan.commentSectionLength)
+
+			let editedText = NSMutableString(string: commit.text)
+			var editedLineIndex = lineIndex
+
+			editedText.insert(insertion, at: 0)
+			editedLineIndex.textDidChange(editedText, editedRange: NSMakeRange(0, insertionLength), changeInLength: insertionLength)
+			assertSameLines(editedLineIndex, CommitLineIndex(text: editedText, versionControlType: commit.versionControlType, commentSectionLength: scan.commentSectionLength), "\(commit.name): line index after inserting a line does not match a rebuilt index")
+
+			editedText.deleteCharacters(in: NSMakeRange(0, insertionLength))
+			editedLineIndex.textDidChange(editedText, editedRange: NSMakeRange(0, 0), changeInLength: -insertionLength)
+			assertSameLines(editedLineIndex, lineIndex, "\(commit.name): line index after removing an inserted line does not match the original index")
+		}
+	}
+
+	// Make a series of edits like the ones users make, checking each incremental update against re-building the index for the edited text.
+	// Each edit returns the range to replace and its replacement for the current text.
+	func testEditSequence() throws {
+		for commit in try CommitTextCorpus.all() {
+			let scan = TextProcessor.scanCommitText(plainText: commit.text, versionControlType: commit.versionControlType)
+
+			let commentLine = TextProcessor.commentLine("Edited comment", versionControlType: commit.versionControlType) + "\n"
+			let firstNewlineLocation = { (text: NSString) -> Int in
+				return text.range(of: "\n").location
+			}
+			let edits: [(String, (NSString) -> (NSRange, String))] = [
+				("inserting a line", { _ in (NSMakeRange(0, 0), "Edited subject\n") }),
+				("typing in the middle of a line", { _ in (NSMakeRange(6, 0), " first") }),
+				("inserting \\r before \\n", { text in (NSMakeRange(firstNewlineLocation(text), 0), "\r") }),
+				("splitting \\r\\n", { text in (NSMakeRange(firstNewlineLocation(text), 0), "x") }),
+				("merging \\r and \\n", { text in (NSMakeRange(firstNewlineLocation(text) - 1, 1), "") }),
+				("deleting a line break", { text in (NSMakeRange(firstNewlineLocation(text) - 1, 2), "") }),
+				("typing before the comment section", { text in (NSMakeRange(max(text.length - scan.commentSectionLength - 1, 0), 0), "Body") }),
+				("inserting a comment line above the content", { _ in (NSMakeRange(0, 0), commentLine) }),
+				("deleting the comment line above the content", { _ in (NSMakeRange(0, commentLine.utf16.count), "") }),
+				("replacing the first line with a comment line", { text in (text.lineRange(for: NSMakeRange(0, 0)), commentLine) })
+			]
+
+			let editedText = NSMutableString(string: commit.text)
+			var editedLineIndex = CommitLineIndex(text: editedText, versionControlType: commit.versionControlType, commentSectionLength: scan.commentSectionLength)
+			for (editDescription, edit) in edits {
+				let (replacedRange, replacement) = edit(editedText)
+				let replacementLength = replacement.utf16.count
+
+				editedText.replaceCharacters(in: replacedRange, with: replacement)
+				editedLineIndex.textDidChange(editedText, editedRange: NSMakeRange(replacedRange.location, replacementLength), changeInLength: replacementLength - replacedRange.length)
+
+				let rebuiltLineIndex = CommitLineIndex(text: editedText, versionControlType: commit.versionControlType, commentSectionLength: scan.commentSectionLength)
+				assertSameLines(editedLineIndex, rebuiltLineIndex, "\(commit.name): line index after \(editDescription) does not match a rebuilt index")
+			}
+		}
+	}
+}
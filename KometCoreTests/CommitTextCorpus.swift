@@ -0,0 +1,60 @@
+//
+//  CommitTextCorpus.swift
+//  KometCoreTests
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import Foundation
+import KometCore
+import KometTestSupport
+
+// Synthetic commits are kept small so the tests check every version control type and variant quickly.
+// KometBenchmarks generates the larger sizes.
+private let SYNTHETIC_BYTE_COUNTS = [1024, 64 * 1024]
+
+// A commit text to check, parsed with the comment style the editor would use for it
+struct CorpusCommit {
+	let name: String
+	let text: String
+	let versionControlType: VersionControlType
+	let isSquashMessage: Bool
+}
+
+enum CommitTextCorpus {
+	static let fixturesURL = URL(fileURLWithPath: #filePath).deletingLastPathComponent().deletingLastPathComponent().appendingPathComponent("KometUITests").appendingPathComponent("Resources")
+
+	// Loads each fixture shared with KometUITests the same way the editor does
+	static func fixtures() throws -> [CorpusCommit] {
+		let fixtureURLs = try FileManager.default.contentsOfDirectory(at: fixturesURL, includingPropertiesForKeys: nil).filter({ !$0.hasDirectoryPath }).sorted(by: { $0.lastPathComponent < $1.lastPathComponent })
+
+		return try fixtureURLs.map({ fixtureURL in
+			let loadedCommit = try LaunchPipeline(fileURL: fixtureURL, options: LaunchPipeline.Options()).wait()
+			return CorpusCommit(name: fixtureURL.lastPathComponent, text: loadedCommit.initialPlainText, versionControlType: loadedCommit.commentVersionControlType, isSquashMessage: loadedCommit.isSquashMessage)
+		})
+	}
+
+	static func syntheticCommits() -> [SyntheticCommit] {
+		var commits: [SyntheticCommit] = []
+		for versionControlType in SyntheticCommit.versionControlTypes {
+			for variant in SyntheticCommitVariant.allCases {
+				for byteCount in SYNTHETIC_BYTE_COUNTS {
+					commits.append(SyntheticCommit(versionControlType: versionControlType, variant: variant, targetByteCount: byteCount))
+				}
+			}
+		}
+		return commits
+	}
+
+	static func all() throws -> [CorpusCommit] {
+		return try fixtures() + syntheticCommits().map({ commit in
+			return CorpusCommit(name: commit.name, text: commit.text, versionControlType: commit.versionControlType, isSquashMessage: false)
+		})
+	}
+
+	static func commentSectionText(_ text: String, commentSectionLength: Int) -> String {
+		let commentSectionIndex = TextProcessor.commentSectionIndex(plainUTF16Text: text.utf16, commentSectionLength: commentSectionLength)
+		return String(text[commentSectionIndex...])
+	}
+}
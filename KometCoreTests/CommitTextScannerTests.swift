@@ -0,0 +1,44 @@
+//
+//  CommitTextScannerTests.swift
+//  KometCoreTests
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import XCTest
+import KometCore
+import KometTestSupport
+
+class CommitTextScannerTests: XCTestCase {
+	// The single pass scanner must find the same comment section and content as the original String based implementation
+	func testScanMatchesReference() throws {
+		for commit in try CommitTextCorpus.all() {
+			let text = commit.text
+			let utf16View = text.utf16
+			let scan = TextProcessor.scanCommitText(plainText: text, versionControlType: commit.versionControlType)
+
+			let referenceCommentSectionLength = ReferenceTextProcessor.commentSectionLength(plainText: text, versionControlType: commit.versionControlType)
+			XCTAssertEqual(scan.commentSectionLength, referenceCommentSectionLength, "\(commit.name): comment section length does not match")
+
+			let firstContentLineOffset = scan.firstContentLineIndex.map({ utf16View.distance(from: utf16View.startIndex, to: $0) })
+			let referenceFirstContentLineOffset = ReferenceTextProcessor.firstContentLineIndex(plainText: text, versionControlType: commit.versionControlType).map({ utf16View.distance(from: utf16View.startIndex, to: $0) })
+			XCTAssertEqual(firstContentLineOffset, referenceFirstContentLineOffset, "\(commit.name): first content line does not match")
+
+			let commitTextEndOffset = utf16View.distance(from: utf16View.startIndex, to: scan.commitTextRange.upperBound)
+			let referenceCommitTextRange = ReferenceTextProcessor.commitTextRange(plainText: text, commentLength: referenceCommentSectionLength)
+			let referenceCommitTextEndOffset = utf16View.distance(from: utf16View.startIndex, to: referenceCommitTextRange.upperBound)
+			XCTAssertEqual(commitTextEndOffset, referenceCommitTextEndOffset, "\(commit.name): commit text end does not match")
+		}
+	}
+
+	// The standalone entry points must agree with the combined scan
+	func testEntryPointsMatchScan() throws {
+		for commit in try CommitTextCorpus.all() {
+			let scan = TextProcessor.scanCommitText(plainText: commit.text, versionControlType: commit.versionControlType)
+
+			XCTAssertEqual(TextProcessor.commitTextRange(plainText: commit.text, commentLength: scan.commentSectionLength), scan.commitTextRange, "\(commit.name): commitTextRange() does not match scanCommitText()")
+			XCTAssertEqual(TextProcessor.firstContentLineIndex(plainText: commit.text, versionControlType: commit.versionControlType), scan.firstContentLineIndex, "\(commit.name): firstContentLineIndex() does not match scanCommitText()")
+		}
+	}
+}
@@ -0,0 +1,109 @@
+//
+//  LaunchPipelineTests.swift
+//  KometCoreTests
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import XCTest
+import KometCore
+import KometTestSupport
+
+class LaunchPipelineTests: XCTestCase {
+	private var temporaryDirectoryURL: URL!
+
+	override func setUpWithError() throws {
+		temporaryDirectoryURL = FileManager.default.temporaryDirectory.appendingPathComponent("KometCoreTests-\(UUID().uuidString)", isDirectory: true)
+		try FileManager.default.createDirectory(at: temporaryDirectoryURL, withIntermediateDirectories: true)
+	}
+
+	override func tearDownWithError() throws {
+		try FileManager.default.removeItem(at: temporaryDirectoryURL)
+	}
+
+	// Launches read the comment syntaxes file like the editor does
+	func testSyntheticCommits() throws {
+		let customCommentSyntaxesURL = temporaryDirectoryURL.appendingPathComponent("CommentSyntaxes.json")
+		try Data(SyntheticCommit.customCommentSyntaxesJSON.utf8).write(to: customCommentSyntaxesURL)
+
+		var options = LaunchPipeline.Options()
+		options.customCommentSyntaxesURL = customCommentSyntaxesURL
+
+		for commit in CommitTextCorpus.syntheticCommits() {
+			let fileURL = temporaryDirectoryURL.appendingPathComponent(commit.fileName)
+			try Data(commit.text.utf8).write(to: fileURL)
+
+			let loadedCommit = try LaunchPipeline(fileURL: fileURL, options: options).wait()
+			let scan = TextProcessor.scanCommitText(plainText: commit.text, versionControlType: commit.versionControlType)
+
+			XCTAssertEqual(loadedCommit.versionControlType, commit.versionControlType, "\(commit.name): detected version control type does not match")
+			XCTAssertFalse(loadedCommit.isSquashMessage, "\(commit.name): detected a squash message")
+			XCTAssertNil(loadedCommit.collapsedScissoredContent, "\(commit.name): collapsed content without a collapse threshold")
+			XCTAssertEqual(loadedCommit.initialPlainText, commit.text, "\(commit.name): loaded different text")
+			XCTAssertEqual(loadedCommit.commentSectionLength, scan.commentSectionLength, "\(commit.name): comment section length does not match")
+			XCTAssertEqual(loadedCommit.initialCommitTextRange, scan.commitTextRange, "\(commit.name): commit text range does not match")
+
+			let highlights = CommentSectionHighlights(commentSectionText: CommitTextCorpus.commentSectionText(commit.text, commentSectionLength: scan.commentSectionLength), versionControlType: commit.versionControlType)
+			XCTAssertEqual(loadedCommit.commentSectionHighlights?.lineCount, highlights.lineCount, "\(commit.name): comment section highlights do not match")
+		}
+	}
+
+	// An incomplete commit message saved by a canceled session is only resumed from if the commit file has no content,
+	// and it's removed either way
+	func testSavedCommitMessages() throws {
+		let savedCommitMessage = "Resumed subject\n\nResumed body\n"
+		let commitTexts: [(name: String, text: String, resumes: Bool)] = [
+			("empty-commit", "\n# Please enter the commit message for your changes.\n", true),
+			("amended-commit", "Existing subject\n\n# Please enter the commit message for your changes.\n", false)
+		]
+
+		for (name, text, resumes) in commitTexts {
+			let fileURL = temporaryDirectoryURL.appendingPathComponent(name)
+			let savedCommitMessageURL = temporaryDirectoryURL.appendingPathComponent("\(name)-saved")
+			try Data(text.utf8).write(to: fileURL)
+			try Data(savedCommitMessage.utf8).write(to: savedCommitMessageURL)
+
+			var options = LaunchPipeline.Options()
+			options.savedCommitMessageURL = savedCommitMessageURL
+			options.savedCommitMessageTimeoutInterval = 60.0 * 60
+
+			let loadedCommit = try LaunchPipeline(fileURL: fileURL, options: options).wait()
+			let expectedText = resumes ? savedCommitMessage + text : text
+			let expectedScan = TextProcessor.scanCommitText(plainText: expectedText, versionControlType: .git)
+
+			XCTAssertEqual(loadedCommit.resumedFromSavedCommit, resumes, "\(name): resumed from saved commit message does not match")
+			XCTAssertEqual(loadedCommit.initialPlainText, expectedText, "\(name): loaded text does not match")
+			XCTAssertEqual(loadedCommit.commentSectionLength, expectedScan.commentSectionLength, "\(name): comment section length does not match")
+			XCTAssertEqual(loadedCommit.initialCommitTextRange, expectedScan.commitTextRange, "\(name): commit text range does not match")
+			XCTAssertFalse(FileManager.default.fileExists(atPath: savedCommitMessageURL.path), "\(name): saved commit message was not removed")
+		}
+	}
+
+	// Large scissored diffs are collapsed, unless the collapsed content isn't valid UTF-8,
+	// in which case loading fails like it does for the rest of the file
+	func testCollapsedContentIsValidated() throws {
+		let commit = SyntheticCommit(versionControlType: .git, variant: .ascii, targetByteCount: 64 * 1024)
+
+		var options = LaunchPipeline.Options()
+		options.collapseThreshold = 1024
+		options.previewLength = 256
+
+		let fileURL = temporaryDirectoryURL.appendingPathComponent(commit.fileName)
+		try Data(commit.text.utf8).write(to: fileURL)
+
+		let loadedCommit = try LaunchPipeline(fileURL: fileURL, options: options).wait()
+		let collapsedScissoredContent = try XCTUnwrap(loadedCommit.collapsedScissoredContent, "\(commit.name): scissored diff was not collapsed")
+		XCTAssertEqual(collapsedScissoredContent.placeholder, TextProcessor.commentLine(CollapsedScissoredContent.placeholderDescription(collapsedByteCount: collapsedScissoredContent.data.count), versionControlType: .git), "\(commit.name): placeholder does not match")
+		XCTAssertTrue(loadedCommit.initialPlainText.hasSuffix(collapsedScissoredContent.placeholder), "\(commit.name): placeholder is not at the end of the loaded text")
+
+		try (Data(commit.text.utf8) + Data([0xFF, 0x0A])).write(to: fileURL)
+
+		XCTAssertThrowsError(try LaunchPipeline(fileURL: fileURL, options: options).wait()) { error in
+			guard case LaunchPipelineError.invalidUTF8 = error else {
+				XCTFail("\(commit.name): failed with \(error) instead of invalid UTF-8")
+				return
+			}
+		}
+	}
+}
@@ -0,0 +1,80 @@
+//
+//  LineMeasurementTests.swift
+//  KometCoreTests
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import XCTest
+import KometCore
+import KometTestSupport
+
+// Lines whose characters aren't all single UTF-16 code units
+private let LINE_MEASUREMENT_EDGE_CASES = [
+	"",
+	"\n",
+	"\r\n",
+	"Subject\r\n",
+	"Carriage\rreturn\n",
+	"e\u{301}\u{301}te\n",
+	"👩‍👩‍👧 family\n",
+	"🇺🇸🇨🇦 flags\r\n",
+	"Tabs\tand spaces \n",
+	String(repeating: "a", count: 100) + "\n",
+	String(repeating: "a", count: 100) + "é"
+]
+
+private let LINE_LENGTH_LIMITS = [0, 1, 2, 5, 10, 16, 72, 100, 101]
+
+class LineMeasurementTests: XCTestCase {
+	// The editor's paragraphs are bridged from NSString, which may store its characters as UTF-16 or as 8-bit code units
+	private func bridgedLines(_ line: String) -> [(String, String)] {
+		let utf16CodeUnits = Array(line.utf16)
+		var bridgedLines = [("UTF-16", String(NSString(characters: utf16CodeUnits, length: utf16CodeUnits.count)))]
+		if let latin1Data = line.data(using: .isoLatin1), let latin1Line = NSString(data: latin1Data, encoding: String.Encoding.isoLatin1.rawValue) {
+			bridgedLines.append(("8-bit", String(latin1Line)))
+		}
+		return bridgedLines
+	}
+
+	func testEdgeCasesMatchReference() {
+		for line in LINE_MEASUREMENT_EDGE_CASES {
+			// Lines that are ASCII, aside from a trailing "\r\n", should be measured without segmenting them into grapheme clusters
+			let lineBytes = line.hasSuffix("\r\n") ? line.utf8.dropLast(2) : line.utf8[...]
+			let expectsASCIIColumnCount = lineBytes.allSatisfy({ $0 < 0x80 && $0 != 0x0D })
+
+			for (storage, measuredLine) in [("native", line)] + bridgedLines(line) {
+				let name = "\(line.debugDescription) (\(storage))"
+				XCTAssertEqual(LineMeasurement.columnCount(line: measuredLine), line.count, "\(name): column count does not match")
+				XCTAssertEqual(LineMeasurement.asciiColumnCount(line: measuredLine) != nil, expectsASCIIColumnCount, "\(name): measured as ASCII does not match")
+
+				for lengthLimit in LINE_LENGTH_LIMITS {
+					XCTAssertEqual(LineMeasurement.overflowUTF16Range(line: measuredLine, lengthLimit: lengthLimit), ReferenceTextProcessor.overflowUTF16Range(line: line, lengthLimit: lengthLimit), "\(name): overflow of \(lengthLimit) characters does not match")
+				}
+			}
+		}
+	}
+
+	// Measures every line including its line break, like the editor's paragraphs
+	func testCorpusLinesMatchReference() throws {
+		for commit in try CommitTextCorpus.all() {
+			let text = NSString(string: commit.text)
+			let scan = TextProcessor.scanCommitText(plainText: commit.text, versionControlType: commit.versionControlType)
+			let lineIndex = CommitLineIndex(text: text, versionControlType: commit.versionControlType, commentSectionLength: scan.commentSectionLength)
+
+			for lineNumber in 0 ..< lineIndex.lineCount {
+				let lineStart = lineIndex.lineStart(at: lineNumber)
+				let lineEnd = (lineNumber + 1 < lineIndex.lineCount) ? lineIndex.lineStart(at: lineNumber + 1) : lineIndex.length
+				let line = text.substring(with: NSMakeRange(lineStart, lineEnd - lineStart))
+				for lengthLimit in LINE_LENGTH_LIMITS {
+					let overflowRange = LineMeasurement.overflowUTF16Range(line: line, lengthLimit: lengthLimit)
+					let referenceOverflowRange = ReferenceTextProcessor.overflowUTF16Range(line: line, lengthLimit: lengthLimit)
+					if overflowRange != referenceOverflowRange {
+						XCTFail("\(commit.name): line \(lineNumber) overflows \(lengthLimit) characters at \(String(describing: overflowRange)) but expected \(String(describing: referenceOverflowRange))")
+					}
+				}
+			}
+		}
+	}
+}
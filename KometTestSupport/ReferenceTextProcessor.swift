@@ -0,0 +1,141 @@
+//
+//  ReferenceTextProcessor.swift
+//  KometTestSupport
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import Foundation
+import KometCore
+
+// The original line by line String implementations that TextProcessor's single pass scanner
+// and LineMeasurement replaced.
+// These are kept unoptimized so the tests can check that the scanner produces the same results
+// and the benchmarks can show how much faster it is.
+public struct ReferenceTextProcessor {
+	// The comment range should begin at the line that starts with a comment string and extend to the end of the file.
+	// Additionally, there should be no content lines (i.e, non comment lines) within this section
+	// (exception: unless we're dealing with svn which only has a starting point for comments)
+	// This should only be computed once, before the user gets a chance to edit the content
+	public static func commentSectionLength(plainText: String, versionControlType: VersionControlType) -> Int {
+		return commentSectionLength(plainText: plainText, commentSyntax: versionControlType.commentSyntax)
+	}
+
+	// The comment syntax is looked up once rather than for every line, so the benchmarks time the line by line algorithm itself
+	private static func commentSectionLength<Syntax: CommentSyntax>(plainText: String, commentSyntax: Syntax) -> Int {
+		let plainTextEndIndex = plainText.endIndex
+		var characterIndex = String.Index(utf16Offset: 0, in: plainText)
+		var lineStartIndex = String.Index(utf16Offset: 0, in: plainText)
+		var lineEndIndex = String.Index(utf16Offset: 0, in: plainText)
+		var contentEndIndex = String.Index(utf16Offset: 0, in: plainText)
+		
+		var foundCommentSection: Bool = false
+		var commentSectionCharacterIndex: String.Index = String.Index(utf16Offset: 0, in: plainText)
+		
+		var passedIntroCommentSection = false
+		
+		while characterIndex < plainTextEndIndex {
+			plainText.getLineStart(&lineStartIndex, end: &lineEndIndex, contentsEnd: &contentEndIndex, for: characterIndex ..< characterIndex)
+			
+			let line = String(plainText[lineStartIndex ..< contentEndIndex])
+			
+			let commentLine = commentSyntax.isCommentLine(line)
+			
+			if !commentLine {
+				if foundCommentSection && (!passedIntroCommentSection || line.trimmingCharacters(in: .whitespacesAndNewlines).count > 0) {
+					// If we found a non-comment line that is not empty, then we have to find a better starting point for the comment section
+					// If we found an empty line but have only just passed the intro comment section, then we need to find a better starting point for the comment section
+					foundCommentSection = false
+				}
+				
+				passedIntroCommentSection = true
+			} else {
+				if !foundCommentSection {
+					foundCommentSection = true
+					commentSectionCharacterIndex = characterIndex
+					
+					// If there's only a single comment line marker, then we're done
+					if commentSyntax.hasSingleCommentLineMarker {
+						break
+					}
+				} else if commentSyntax.isScissorLine(line) {
+					// Everything below the scissor line is non-editable content which will be part of the comment section
+					// Content bellow the scissor line may include lines that show a diff of a commit message and aren't prefixed by a comment character
+					break
+				}
+			}
+			
+			characterIndex = lineEndIndex
+		}
+		
+		return foundCommentSection ? (plainText.utf16.count - commentSectionCharacterIndex.utf16Offset(in: plainText)) : 0
+	}
+	
+	// Find the first commit line. The first lines may be comment lines, which
+	// we'll need to skip
+	public static func firstContentLineIndex(plainText: String, versionControlType: VersionControlType) -> String.Index? {
+		return firstContentLineIndex(plainText: plainText, commentSyntax: versionControlType.commentSyntax)
+	}
+
+	private static func firstContentLineIndex<Syntax: CommentSyntax>(plainText: String, commentSyntax: Syntax) -> String.Index? {
+		let plainTextEndIndex = plainText.endIndex
+		var characterIndex = String.Index(utf16Offset: 0, in: plainText)
+		var lineStartIndex = String.Index(utf16Offset: 0, in: plainText)
+		var lineEndIndex = String.Index(utf16Offset: 0, in: plainText)
+		var contentEndIndex = String.Index(utf16Offset: 0, in: plainText)
+		
+		while characterIndex < plainTextEndIndex {
+			plainText.getLineStart(&lineStartIndex, end: &lineEndIndex, contentsEnd: &contentEndIndex, for: characterIndex ..< characterIndex)
+			
+			let line = String(plainText[lineStartIndex ..< contentEndIndex])
+			guard commentSyntax.isCommentLine(line) else {
+				return lineStartIndex
+			}
+			
+			characterIndex = lineEndIndex
+		}
+		
+		return nil
+	}
+
+	// The content range should extend to before the comments, only allowing one trailing newline in between the comments and content
+	// Make sure to scan from the bottom to top
+	public static func commitTextRange(plainText: String, commentLength: Int) -> Range<String.UTF16View.Index> {
+		let utf16View = plainText.utf16
+		var bestEndCharacterIndex = utf16View.index(utf16View.endIndex, offsetBy: -commentLength)
+		
+		var passedNewline = false
+		
+		let startIndex = utf16View.startIndex
+		while bestEndCharacterIndex > startIndex {
+			let priorCharacterIndex = plainText.index(before: bestEndCharacterIndex)
+			
+			let character = plainText[priorCharacterIndex]
+			if character == "\n" {
+				bestEndCharacterIndex = priorCharacterIndex
+				
+				if passedNewline {
+					break;
+				} else {
+					passedNewline = true
+				}
+			} else {
+				break
+			}
+		}
+
+		return startIndex ..< bestEndCharacterIndex
+	}
+
+	// The range of the line past the length limit (in characters), relative to the start of the line
+	public static func overflowUTF16Range(line: String, lengthLimit: Int) -> NSRange? {
+		let distance = line.distance(from: line.startIndex, to: line.endIndex)
+		guard distance > lengthLimit else {
+			return nil
+		}
+
+		let overflowRange = line.index(line.startIndex, offsetBy: lengthLimit) ..< line.endIndex
+		return TextProcessor.convertToUTF16Range(range: overflowRange, in: line)
+	}
+}
@@ -0,0 +1,252 @@
+//
+//  SyntheticCommit.swift
+//  KometTestSupport
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import Foundation
+import KometCore
+
+// Custom comment syntaxes are tested and benchmarked like the built-in ones, as if they were read from the user's comment syntaxes file
+private let CUSTOM_COMMENT_SYNTAXES_JSON = """
+[
+	{
+		"name": "git-semicolon",
+		"filePatterns": ["*/git-semicolon-*"],
+		"versionControl": "git",
+		"commentPrefix": ";",
+		"scissors": true,
+		"labelSeparator": "colon",
+		"fileChangeLabels": {"modified": "modified", "new file": "added", "deleted": "deleted"},
+		"highlightsScissoredDiffs": true
+	},
+	{
+		"name": "custom-ignore-rest",
+		"filePatterns": ["*/custom-ignore-rest-*"],
+		"commentPrefix": "CM:",
+		"scissorLine": "CM: ignore-rest",
+		"labelSeparator": "whitespace",
+		"fileChangeLabels": {"M": "modified", "A": "added", "R": "deleted"},
+		"highlightsScissoredDiffs": true
+	},
+	{
+		"name": "custom-file-list",
+		"filePatterns": ["*/custom-file-list-*"],
+		"commentPrefix": "CF:",
+		"labelSeparator": "whitespace",
+		"fileChangeLabels": {"M": "modified", "A": "added", "R": "deleted"}
+	}
+]
+"""
+
+public enum SyntheticCommitVariant: String, CaseIterable {
+	case ascii
+	case emoji
+	case crlf
+}
+
+// A generated commit message template that resembles what each version control system hands to the editor.
+// git and jj templates end with a scissored diff that makes up most of the file,
+// while hg and svn templates have a long list of changed files in their comment section instead.
+public struct SyntheticCommit {
+	public let name: String
+	public let fileName: String
+	public let versionControlType: VersionControlType
+	public let text: String
+
+	// Number of diff header, added, and removed lines in the scissored diff
+	public let expectedDiffLineCounts: (header: Int, add: Int, remove: Int)?
+
+	public init(versionControlType: VersionControlType, variant: SyntheticCommitVariant, targetByteCount: Int) {
+		let lineBreak = (variant == .crlf) ? "\r\n" : "\n"
+		let decoration = (variant == .emoji) ? " 📝✨👩‍👩‍👧" : ""
+
+		var lines: [String] = [
+			"Add synthetic benchmark content\(decoration)",
+			"",
+			"This commit message was generated for benchmarking\(decoration)",
+			""
+		]
+
+		switch versionControlType {
+		case .git:
+			lines += [
+				"# Please enter the commit message for your changes. Lines starting",
+				"# with '#' will be ignored, and an empty message aborts the commit.",
+				"#",
+				"# On branch main",
+				"# Changes to be committed:",
+				"#\tmodified:   Sources/File0.swift",
+				"#\tnew file:   Sources/File1.swift",
+				"#\tdeleted:    Sources/File2.swift",
+				"#"
+			]
+		case .hg:
+			lines += [
+				"HG: Enter commit message.  Lines beginning with 'HG:' are removed.",
+				"HG: Leave message empty to abort commit.",
+				"HG: --",
+				"HG: user: Komet <komet@example.com>",
+				"HG: branch 'default'"
+			]
+		case .svn:
+			lines += [
+				"--This line, and those below, will be ignored--",
+				""
+			]
+		case .jj:
+			lines += [
+				"JJ: This commit contains the following changes:",
+				"JJ:     M Sources/File0.swift",
+				"JJ:     A Sources/File1.swift",
+				"JJ:     D Sources/File2.swift",
+				"JJ:"
+			]
+		case .custom(let commentSyntax):
+			lines += [
+				commentSyntax.commentLine("Please enter the commit message for your changes."),
+				commentSyntax.commentLine("On branch main")
+			]
+		}
+
+		// Non-ASCII characters right after a comment marker take the scanner's slower grapheme checks
+		if variant == .emoji {
+			let (commentPrefix, commentSuffix) = TextProcessor.commentMarkers(versionControlType: versionControlType)
+			lines.append(commentSuffix.isEmpty ? "\(commentPrefix)📝 note next to the comment marker" : "\(commentPrefix)📝 note next to the comment markers 📝\(commentSuffix)")
+		}
+
+		switch versionControlType {
+		case .git:
+			lines += [
+				"# ------------------------ >8 ------------------------",
+				"# Do not modify or remove the line above.",
+				"# Everything below it will be ignored."
+			]
+		case .jj:
+			lines.append("JJ: ignore-rest")
+		case .hg:
+			break
+		case .svn:
+			break
+		case .custom(let commentSyntax):
+			switch commentSyntax.scissorRule {
+			case .none:
+				break
+			case .scissors:
+				lines.append("\(commentSyntax.prefix) ------------------------ >8 ------------------------")
+			case .exactLine(let scissorLine):
+				lines.append(scissorLine)
+			}
+		}
+
+		let lineBreakByteCount = lineBreak.utf8.count
+		var byteCount = lines.reduce(0, { $0 + $1.utf8.count + lineBreakByteCount })
+
+		let highlightsScissoredDiffs = TextProcessor.highlightsScissoredDiffs(versionControlType: versionControlType)
+
+		var fileCount = 0
+		while byteCount < targetByteCount {
+			let filePath = "Sources/File\(fileCount).swift"
+
+			let fileLines: [String]
+			if highlightsScissoredDiffs {
+				fileLines = [
+					"diff --git a/\(filePath) b/\(filePath)",
+					"index 1a2b3c4..5d6e7f8 100644",
+					"--- a/\(filePath)",
+					"+++ b/\(filePath)",
+					"@@ -1,4 +1,4 @@",
+					" let unchanged = \(fileCount)",
+					"-let removed = \"old value\(decoration)\"",
+					"+let added = \"new value\(decoration)\"",
+					" // End of file"
+				]
+			} else {
+				switch versionControlType {
+				case .hg:
+					fileLines = ["HG: changed \(filePath)\(decoration)"]
+				case .svn:
+					fileLines = ["M       \(filePath)\(decoration)"]
+				case .custom(let commentSyntax):
+					fileLines = [commentSyntax.commentLine("M \(filePath)\(decoration)")]
+				case .git:
+					fallthrough
+				case .jj:
+					fileLines = []
+				}
+			}
+
+			lines += fileLines
+			byteCount += fileLines.reduce(0, { $0 + $1.utf8.count + lineBreakByteCount })
+			fileCount += 1
+		}
+
+		let sizeDescription = Self.sizeDescription(targetByteCount)
+		let versionControlName = Self.versionControlName(versionControlType)
+		name = "\(versionControlName)-\(variant.rawValue)-\(sizeDescription)"
+
+		// File names are picked so TextProcessor.versionControlType(fileURL:customCommentSyntaxes:) detects the right type
+		switch versionControlType {
+		case .jj:
+			fileName = "\(name).jjdescription"
+		case .git:
+			fallthrough
+		case .hg:
+			fallthrough
+		case .svn:
+			fallthrough
+		case .custom:
+			fileName = name
+		}
+
+		self.versionControlType = versionControlType
+		text = lines.joined(separator: lineBreak) + lineBreak
+		expectedDiffLineCounts = highlightsScissoredDiffs ? (header: fileCount * 5, add: fileCount, remove: fileCount) : nil
+	}
+
+	public static func versionControlName(_ versionControlType: VersionControlType) -> String {
+		switch versionControlType {
+		case .git:
+			return "git"
+		case .hg:
+			return "hg"
+		case .svn:
+			return "svn"
+		case .jj:
+			return "jj"
+		case .custom(let commentSyntax):
+			return commentSyntax.name
+		}
+	}
+
+	public static func sizeDescription(_ byteCount: Int) -> String {
+		if byteCount >= 1024 * 1024 && byteCount % (1024 * 1024) == 0 {
+			return "\(byteCount / (1024 * 1024))MB"
+		} else if byteCount >= 1024 && byteCount % 1024 == 0 {
+			return "\(byteCount / 1024)KB"
+		} else {
+			return "\(byteCount)B"
+		}
+	}
+}
+
+extension SyntheticCommit {
+	public static var customCommentSyntaxesJSON: String {
+		return CUSTOM_COMMENT_SYNTAXES_JSON
+	}
+
+	public static let customCommentSyntaxes: [CustomCommentSyntax] = {
+		do {
+			return try JSONDecoder().decode([CustomCommentSyntax].self, from: Data(CUSTOM_COMMENT_SYNTAXES_JSON.utf8))
+		} catch {
+			fatalError("Failed to decode custom comment syntaxes: \(error)")
+		}
+	}()
+
+	// The built-in version control types followed by the custom comment syntaxes
+	public static var versionControlTypes: [VersionControlType] {
+		return [.git, .hg, .svn, .jj] + customCommentSyntaxes.map({ .custom($0) })
+	}
+}
@@ -0,0 +1,74 @@
+//
+//  ToolRepositoryFixture.swift
+//  KometTestSupport
+//
+//  Created by Mayur Pawashe on 10/17/26.
+//  Copyright © 2026 zgcoder. All rights reserved.
+//
+
+import Foundation
+import KometCore
+
+// A repository created by git or hg, used to compare the resolver against asking the tool at launch
+public struct ToolRepositoryFixture {
+	public let name: String
+	public let versionControlType: VersionControlType
+	public let workingDirectoryURL: URL
+
+	public static let branchName = "benchmark"
+
+	// Returns nil if the tool isn't installed or fails to create the repository
+	public static func create(versionControlType: VersionControlType, in directoryURL: URL) -> ToolRepositoryFixture? {
+		let name: String
+		let commands: [[String]]
+		switch versionControlType {
+		case .git:
+			name = "git-repository"
+			commands = [
+				["git", "init", "-q"],
+				["git", "symbolic-ref", "HEAD", "refs/heads/\(branchName)"],
+				["git", "-c", "user.name=Komet", "-c", "user.email=komet@example.com", "commit", "-q", "--allow-empty", "-m", "Initial commit"]
+			]
+		case .hg:
+			name = "hg-repository"
+			commands = [
+				["hg", "init"],
+				["hg", "branch", "-q", branchName]
+			]
+		case .svn, .jj, .custom:
+			return nil
+		}
+
+		let workingDirectoryURL = directoryURL.appendingPathComponent(name, isDirectory: true)
+		do {
+			try FileManager.default.createDirectory(at: workingDirectoryURL, withIntermediateDirectories: true)
+		} catch {
+			return nil
+		}
+
+		for arguments in commands {
+			guard run(arguments, in: workingDirectoryURL) else {
+				return nil
+			}
+		}
+
+		return ToolRepositoryFixture(name: name, versionControlType: versionControlType, workingDirectoryURL: workingDirectoryURL)
+	}
+
+	private static func run(_ arguments: [String], in workingDirectoryURL: URL) -> Bool {
+		let process = Process()
+		process.executableURL = URL(fileURLWithPath: "/usr/bin/env")
+		process.arguments = arguments
+		process.currentDirectoryURL = workingDirectoryURL
+		process.standardOutput = FileHandle.nullDevice
+		process.standardError = FileHandle.nullDevice
+
+		do {
+			try process.run()
+			process.waitUntilExit()
+			return process.terminationStatus == EXIT_SUCCESS
+		} catch {
+			return false
+		}
+	}
+}
@@ -23,7 +23,7 @@ class KometApp {
 	private let tempDirectoryURL: URL
 	private let breadcrumbsURL: URL
 	
-	init(filename: String, automicNewlineInsertion: Bool = true, resumeIncompleteSession: Bool = false, versionControlledFile: Bool = true, enableContentBreadcrumbs: Bool = true) throws {
+	init(filename: String, appendingContent appendedContent: String = "", automicNewlineInsertion: Bool = true, resumeIncompleteSession: Bool = false, versionControlledFile: Bool = true, enableContentBreadcrumbs: Bool = true, scissoredContentCollapseThreshold: Int = 8 * 1024 * 1024) throws {
 		let bundle = Bundle(for: Self.self)
 		let resourceURL = bundle.url(forResource: filename, withExtension: "")!
 		
@@ -38,6 +38,15 @@ class KometApp {
 		fileURL = tempDirectoryURL.appendingPathComponent(resourceURL.lastPathComponent)
 		try fileManager.copyItem(at: resourceURL, to: fileURL)
 		
+		if !appendedContent.isEmpty {
+			let fileHandle = try FileHandle(forWritingTo: fileURL)
+			defer {
+				fileHandle.closeFile()
+			}
+			fileHandle.seekToEndOfFile()
+			fileHandle.write(appendedContent.data(using: .utf8)!)
+		}
+		
 		initialContent = try String(contentsOf: fileURL)
 		
 		let key = { (defaultName: String) in
@@ -68,7 +77,8 @@ class KometApp {
 			 key(ZGAssumeVersionControlledFileKey), String(versionControlledFile),
 			 key(ZGCommitTextViewContinuousSpellCheckingKey), String(true),
 			 key(ZGCommitTextViewAutomaticSpellingCorrectionKey), String(false),
-			 key(ZGCommitTextViewAutomaticTextReplacementKey), String(false)]
+			 key(ZGCommitTextViewAutomaticTextReplacementKey), String(false),
+			 key(ZGScissoredContentCollapseThresholdKey), String(scissoredContentCollapseThreshold)]
 		
 		application.launchEnvironment = [
 			ZGBreadcrumbsURLKey: breadcrumbsURL.path,
@@ -169,6 +179,14 @@ class KometApp {
 		}
 	}
 	
+	var text: String {
+		return textView.value as? String ?? ""
+	}
+	
+	func clickFirstLink() {
+		textView.links.firstMatch.click()
+	}
+	
 	func selectAll() {
 		application.menuBars.menuBarItems["Edit"].menuItems["Select All"].click()
 	}
@@ -764,6 +782,50 @@ class KometUITests: XCTestCase {
 		XCTAssertEqual(breadcrumbs!.diffRemoveLineRanges.count, 0)
 	}
 	
+	// MARK: Collapsed Scissored Content
+	
+	// A diff below the scissor line that is larger than the amount of collapsed content that is still loaded (256 KB)
+	private func largeScissoredDiff() -> String {
+		var diff = "diff --git a/large b/large\nnew file mode 100644\nindex 0000000..f3d3463\n--- /dev/null\n+++ b/large\n@@ -0,0 +1,40000 @@\n"
+		for lineNumber in 1 ... 40000 {
+			diff += "+Line \(lineNumber) of a large file\n"
+		}
+		return diff
+	}
+	
+	func testCollapsedScissoredContent() throws {
+		let app = try KometApp(filename: "new-commit-scissor", appendingContent: largeScissoredDiff(), scissoredContentCollapseThreshold: 64 * 1024)
+		
+		XCTAssertTrue(app.text.contains("of content below was not loaded"))
+		XCTAssertFalse(app.text.contains("+Line 40000 of a large file"))
+		
+		let newContent = "Hello there"
+		app.typeText(newContent)
+		
+		// The content that was never loaded is written back unchanged
+		let (breadcrumbs, finalContent) = try app.commit()
+		XCTAssertEqual(breadcrumbs!.exitStatus, 0, "commit failed with non-zero status")
+		XCTAssertEqual(newContent + app.initialContent, finalContent)
+	}
+	
+	func testExpandingCollapsedScissoredContent() throws {
+		let app = try KometApp(filename: "new-commit-scissor", appendingContent: largeScissoredDiff(), scissoredContentCollapseThreshold: 64 * 1024)
+		
+		XCTAssertTrue(app.text.contains("of content below was not loaded"))
+		
+		let newContent = "Hello there"
+		app.typeText(newContent)
+		
+		app.clickFirstLink()
+		
+		XCTAssertFalse(app.text.contains("of content below was not loaded"))
+		XCTAssertTrue(app.text.hasSuffix("+Line 40000 of a large file\n"))
+		
+		let (breadcrumbs, finalContent) = try app.commit()
+		XCTAssertEqual(breadcrumbs!.exitStatus, 0, "commit failed with non-zero status")
+		XCTAssertEqual(newContent + app.initialContent, finalContent)
+	}
+	
 	func testFilesChanged() throws {
 		let app = try KometApp(filename: "files-changed")
 	
@@ -0,0 +1,44 @@
+// swift-tools-version:5.9
+
+import PackageDescription
+
+// Builds the parts of Komet that don't depend on AppKit so they can be tested, analyzed, and benchmarked on any platform, including Linux.
+// The app itself is built with Komet.xcodeproj, which compiles the KometCore sources directly into the app.
+let package = Package(
+	name: "Komet",
+	platforms: [
+		.macOS(.v12)
+	],
+	products: [
+		.library(name: "KometCore", targets: ["KometCore"]),
+		.executable(name: "KometBenchmarks", targets: ["KometBenchmarks"]),
+		.executable(name: "komet-analyze", targets: ["KometAnalyze"])
+	],
+	targets: [
+		.target(
+			name: "KometCore",
+			path: "KometCore"
+		),
+		// Synthetic commits and reference implementations shared by the tests and benchmarks
+		.target(
+			name: "KometTestSupport",
+			dependencies: ["KometCore"],
+			path: "KometTestSupport"
+		),
+		.executableTarget(
+			name: "KometBenchmarks",
+			dependencies: ["KometCore", "KometTestSupport"],
+			path: "KometBenchmarks"
+		),
+		.executableTarget(
+			name: "KometAnalyze",
+			dependencies: ["KometCore"],
+			path: "KometAnalyze"
+		),
+		.testTarget(
+			name: "KometCoreTests",
+			dependencies: ["KometCore", "KometTestSupport"],
+			path: "KometCoreTests"
+		)
+	]
+)